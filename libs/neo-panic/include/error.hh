@@ -13,6 +13,7 @@
 #define __ERROR_HH__
 
 #include <cstdio>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -79,6 +80,7 @@ using fix_pair     = std::pair<__TOKEN_N::Token, i64>;
 using fix_pair_vec = std::vector<fix_pair>;
 using errors_rep   = std::vector<_internal_error>;
 
+inline std::mutex PANIC_LOCK;  // code generation may report errors from several threads
 inline bool       HAS_ERRORED = false;
 inline bool       SHOW_ERROR  = true;
 inline errors_rep ERRORS;
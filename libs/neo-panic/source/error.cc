@@ -139,8 +139,9 @@ lines_vec get_surrounding_lines(const string &file_name, u64 line) {
     for (u64 i = start_line; i < start_line + LINES_TO_SHOW; ++i) {
         auto line_content = __CONTROLLER_FS_N::get_line(file_name, i);
         if (line_content.has_value()) {
-            lines.emplace_back(false,
-                               std::make_tuple(std::to_string(i), line_content.value(), i == line));
+            lines.emplace_back(
+                false,
+                std::make_tuple(std::to_string(i), std::string(line_content.value()), i == line));
         } else {
             break;
         }
@@ -378,6 +379,8 @@ Panic::Panic(const CodeError &err)
     : level_len(err.level == NONE ? set_level(final_err.level, err.err_code)
                                   : set_level(final_err.level, err.level))
     , mark_pof(err.mark_pof) {
+    std::scoped_lock guard(PANIC_LOCK);
+
     auto err_map_at            = ERROR_MAP.at(static_cast<float>(err.err_code));
     bool internal_core_lib_err = false;
 
@@ -442,6 +445,8 @@ Panic::Panic(const CodeError &err)
 
 Panic::Panic(const CompilerError &err)
     : level_len(set_level(final_err.level, err.err_code)) {
+    std::scoped_lock guard(PANIC_LOCK);
+
     auto err_map_at = ERROR_MAP.at(static_cast<float>(err.err_code));
 
     if (err_map_at == std::nullopt) {
@@ -489,7 +494,7 @@ void Panic::process_full_line() {
     }
 
     while (!full_line->empty() && full_line->back() == ' ') {  // trim trailing spaces
-        full_line->pop_back();
+        full_line->remove_suffix(1);
     }
 
     final_err.full_line = full_line.value();
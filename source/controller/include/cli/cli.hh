@@ -73,12 +73,21 @@ options:
     --emit-llvm              Show LLVM IR.
     --emit-asm               Show assembly.
     --emit-ast               Show AST in json format
+    --emit-ast-beve          Write AST in binary json (BEVE) format to stdout
     --emit-ir                Show intermediate representation. (C++)
     --emit-doc               Only extract doc-comments along with signatures in json format.
 
     --toolchain <options-3>  Set the toolchain to use
 
     --config <file>          Specify configuration file.
+    --profile <name>         Build profile: dev, release, max or size. (default: release)
+    --profile-generate       Build an instrumented binary, its runs record to <output>.profile.
+    --profile-use <dir>      Optimize with the profile recorded in dir. (or a .profdata file)
+    --split <n>              Split the generated C++ into up to n translation units.
+    -j --jobs <n>            C++ compiler processes to run at once. (0: one per core)
+    --in-process             Compile the generated C++ with the built-in clang.
+    --no-cache               Always run the C++ compiler, ignoring the object cache.
+    --pipe                   Feed the generated C++ to the C++ compiler through stdin.
     -r --release             Build in release mode.
     -d --debug               Build in debug mode with symbols.
 
@@ -92,7 +101,8 @@ options-2:
 
 options-3:
     --target <triple>        Target triple.
-    --arch   <arch>          Target architecture.
+    --arch   <arch>          Target instruction set (-march), native for this machine.
+    --cpu    <cpu>           CPU to tune for (-mtune, -mcpu outside x86), native as well.
     --os     <os>            Target operating system.
     --sdk    <sdk-path>      Optional Path to a sdk.
 
@@ -110,10 +120,14 @@ __CONTROLLER_CLI_BEGIN {
         enum class MODE : char { RELEASE = 'r', DEBUG_ = 'd' };
         enum class ABI : char { PYTHON = 'p', RUST = 'r', CXX = 'c', HELIX = 'h' };
 
+        /// how the generated c++ is optimized and linked, see `BuildProfile`
+        enum class PROFILE : char { DEV = 'd', RELEASE = 'r', MAX = 'm', SIZE = 's' };
+
         std::string                file;
         std::optional<std::string> output_file;
         // Options
-        OPTIMIZATION optimize;
+        std::optional<OPTIMIZATION> optimize;  // overrides the level `profile` optimizes at
+        PROFILE                     profile = PROFILE::RELEASE;
 
         bool help    = false;
         bool verbose = false;
@@ -122,14 +136,21 @@ __CONTROLLER_CLI_BEGIN {
         bool exit_   = false;
         int  exit_co = 0;
 
-        bool emit_tokens = false;
-        bool emit_llvm   = false;
-        bool lsp_mode    = false;
-        bool emit_asm    = false;
-        bool emit_ast    = false;
-        bool emit_cst    = false;
-        bool emit_ir     = false;
-        bool emit_doc    = false;
+        bool emit_tokens   = false;
+        bool emit_llvm     = false;
+        bool lsp_mode      = false;
+        bool emit_asm      = false;
+        bool emit_ast      = false;
+        bool emit_ast_beve = false;
+        bool emit_cst      = false;
+        bool emit_ir       = false;
+        bool emit_doc      = false;
+        bool in_process    = false;
+        bool no_cache      = false;
+        bool pipe          = false;  // the cx-ir is only written out when it has to be
+
+        bool        profile_generate = false;  // records to `<output>.profile`
+        std::string profile_use;               // a directory recorded by `profile_generate`
 
         struct tool_chain {
             std::string target;
@@ -142,6 +163,9 @@ __CONTROLLER_CLI_BEGIN {
 
         std::string config_file;
 
+        size_t split_units = 1;  // translation units the generated c++ is split into
+        size_t jobs        = 0;  // 0 = one compiler process per hardware thread
+
         MODE build_mode;
         ABI  build_lib;  // if --lib is passed without [-py, -rs, -cx, -hlx] then assume -hlx
 
@@ -33,11 +33,15 @@ constexpr CF defineFlag{"-D", "-D", "/D", "-D"};
 constexpr CF includeFlag{"-I", "-I", "/I", "-I"};
 constexpr CF linkFlag{"-l", "-l", "/link", "-l"};
 constexpr CF linkTimeOptimizationFlag{"-flto", "-flto", "/LTCG", "-flto"};
+constexpr CF thinLTOFlag{"-flto=auto", "-flto=thin", "/LTCG", "-flto=auto"};  // gcc has no thin lto
+constexpr CF lldLinkerFlag{"-fuse-ld=lld", "-fuse-ld=lld", "", "-fuse-ld=lld"};
 constexpr CF outputFlag{"-o", "-o", "/Fe:", "-o"};
 constexpr CF inputFlag{"-i", "-i", "/Fi:", "-i"};
 constexpr CF precompiledHeaderFlag{"-include", "-include", "/FI", "-include"};
 constexpr CF preprocessorFlag{"-E", "-E", "/P", "-E"};
 constexpr CF compileOnlyFlag{"-c", "-c", "/c", "-c"};
+constexpr CF cxxHeaderFlag{"-xc++-header", "-xc++-header", "/Yc", "-xc++-header"};  // make a pch
+constexpr CF includePCHFlag{"-include", "-include-pch", "/Yu", "-include"};  // gcc finds `.gch`
 constexpr CF noEntryFlag{"-nostartfiles", "-nostartfiles", "/NOENTRY", "-nostartfiles"};
 constexpr CF noDefaultLibrariesFlag{
     "-nodefaultlibs", "-nodefaultlibs", "/NODEFAULTLIB", "-nodefaultlibs"};
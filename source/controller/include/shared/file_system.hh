@@ -18,9 +18,11 @@
 
 #include <cerrno>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -43,7 +45,9 @@ __CONTROLLER_FS_BEGIN {
     std::string read_file(std::string & filename);
     std::string read_file(const std::string &filename);
 
-    std::optional<std::string> get_line(const std::string &filename, u64 line);
+    /// \returns line `line` (from 1) of `filename` without its newline, nullopt past the last one.
+    /// the view stays valid for the rest of the run, see `LineIndex`
+    std::optional<std::string_view> get_line(const std::string &filename, u64 line);
 
     class FileCache {
       public:
@@ -55,6 +59,26 @@ __CONTROLLER_FS_BEGIN {
         static std::mutex                                   mutex_;
     };
 
+    /// where every line of a file starts, built once per file (from what `read_file` returns) and
+    /// never changed after, so diagnostics do not rescan the file for each line they show
+    class LineIndex {
+      public:
+        explicit LineIndex(std::string source);
+
+        /// \returns the index of `filename`, shared by everyone asking for the same name
+        static std::shared_ptr<const LineIndex> of(const std::string &filename);
+
+        /// \returns line `line` (from 1) without its newline, nullopt past the last one
+        [[nodiscard]] std::optional<std::string_view> line(u64 line) const;
+
+      private:
+        std::string         source;
+        std::vector<size_t> starts;  // offset of each line in `source`
+
+        static std::unordered_map<std::string, std::shared_ptr<const LineIndex>> cache_;
+        static std::mutex                                                        mutex_;
+    };
+
     class SourceTree {
       public:
         struct Node {
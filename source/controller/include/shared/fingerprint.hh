@@ -0,0 +1,69 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __FINGERPRINT_HH__
+#define __FINGERPRINT_HH__
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "neo-types/include/hxint.hh"
+
+/// 64 bit fnv-1a over everything a cached artifact depends on. stable between runs and
+/// machines, not meant to resist collisions made on purpose
+class Fingerprint {
+  public:
+    Fingerprint &add(const void *data, size_t len) {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+
+        for (size_t i = 0; i < len; ++i) {
+            hash = (hash ^ bytes[i]) * PRIME;
+        }
+
+        return *this;
+    }
+
+    /// strings are terminated so "ab" + "c" and "a" + "bc" differ
+    Fingerprint &add(std::string_view str) {
+        add(str.data(), str.size());
+        return add("", 1);
+    }
+
+    template <typename T>
+        requires(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_array_v<T>)
+    Fingerprint &add(const T &val) {
+        return add(&val, sizeof(T));
+    }
+
+    [[nodiscard]] u64 value() const { return hash; }
+
+    /// \returns the value as 16 hex digits, usable as a file name
+    [[nodiscard]] std::string hex() const {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+
+        return name;
+    }
+
+  private:
+    static constexpr u64 OFFSET = 14695981039346656037ULL;
+    static constexpr u64 PRIME  = 1099511628211ULL;
+
+    u64 hash = OFFSET;
+};
+
+#endif  // __FINGERPRINT_HH__
@@ -3,17 +3,23 @@
 
 #include <chrono>
 #include <filesystem>
+#include <functional>
+#include <map>
 #include <neo-panic/include/error.hh>
 #include <neo-pprint/include/hxpprint.hh>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "controller/include/Controller.hh"
 #include "controller/include/config/Controller_config.def"
 #include "controller/include/config/cxx_flags.hh"
 #include "controller/include/shared/eflags.hh"
 #include "generator/include/CX-IR/CXIR.hh"
+#include "parser/ast/include/types/AST_reachability_visitor.hh"
 #include "token/include/private/Token_base.hh"
 
 #define IS_UNIX                                                                                    \
@@ -35,9 +41,13 @@ class ImportProcessor;
 namespace flag {
 namespace types {
     enum class CompileFlags : u8 {
-        None    = 0,
-        Debug   = 1 << 0,
-        Verbose = 1 << 1,
+        None        = 0,
+        Debug       = 1 << 0,
+        Verbose     = 1 << 1,
+        InProcess   = 1 << 2,  // compile with the linked in clang, see `CXIR_CLANG`
+        NoCache     = 1 << 3,  // always run the c++ compiler, see `ObjectCache`
+        StableNames = 1 << 4,  // name the cx-ir after the helix source, profiles refer to it
+        Pipe        = 1 << 5,  // feed the cx-ir to the c++ compiler on stdin, see `CXIR_CXX`
     };
 
     enum class Compiler : u8 {
@@ -58,6 +68,30 @@ using ErrorType    = EFlags<flag::types::ErrorType>;
 
 inline bool LSP_MODE = false;
 
+/// the flags the generated c++ is optimized and linked with, chosen by `CLIArgs::PROFILE`
+struct BuildProfile {
+    cxx::flags::CF optimize = cxx::flags::optimizationLevel3;
+    cxx::flags::CF lto      = cxx::flags::thinLTOFlag;  // left out when the toolchain has no lto
+
+    std::string target;  // triple to cross compile for, empty for the host
+    std::string arch;    // instruction set (-march), `native` for the machine building it
+    std::string cpu;     // cpu to tune for (-mtune, -mcpu outside x86), `native` as well
+
+    std::filesystem::path profile_generate;  // instrument, running it records a profile here
+    std::filesystem::path profile_use;       // a recorded profile directory (or .profdata)
+
+    /// \param level replaces the optimization level of `profile`, levels past 3 are -O3
+    /// \param toolchain `--target`, `--arch` and `--cpu`, an arch or cpu replaces the profile's
+    [[nodiscard]] static BuildProfile
+    of(__CONTROLLER_CLI_N::CLIArgs::PROFILE                     profile,
+       std::optional<__CONTROLLER_CLI_N::CLIArgs::OPTIMIZATION> level     = std::nullopt,
+       const __CONTROLLER_CLI_N::CLIArgs::tool_chain           &toolchain = {});
+
+    /// \returns the target, instruction set and cpu flags as `compiler` spells them, needed when
+    /// compiling and when linking (lto generates code at link time)
+    [[nodiscard]] std::string codegen(flag::types::Compiler compiler) const;
+};
+
 /// CXIRCompiler compiler;
 /// compiler.compile_CXIR(CXXCompileAction::init(emitter, out, flags, cxx_args));
 /// NOTE: init returns a rvalue reference you can not assign it to a variable
@@ -74,8 +108,29 @@ struct CXXCompileAction {  // NOLINT
     flag::CompileFlags flags;
     std::string        cxx_compiler;
 
-    static CXXCompileAction
-         init(CXIR &emitter, const Path &cc_out, flag::CompileFlags flags, Args cxx_args);
+    /// where each part of `cc_source` was lowered from, null until `init` wrote it
+    std::shared_ptr<generator::CXIR::SourceMap> source_map;
+
+    /// a translation unit besides `cc_source` when the cx-ir was split, see `CXIR::split`
+    struct Part {
+        Path                                        cc_source;
+        std::shared_ptr<generator::CXIR::SourceMap> source_map;
+    };
+
+    std::vector<Part> parts;
+
+    /// the cx-ir itself when it is compiled in process or piped, `cc_source` is then only its name
+    std::shared_ptr<const std::string> cc_text;
+    size_t            jobs = 0;  // compiler processes run at once, 0 = one per hardware thread
+    BuildProfile      profile;
+
+    /// \param units the number of translation units to split the cx-ir into, at most
+    static CXXCompileAction init(CXIR              &emitter,
+                                 const Path        &cc_out,
+                                 flag::CompileFlags flags,
+                                 Args               cxx_args,
+                                 size_t             units = 1,
+                                 size_t             jobs  = 0);
     void cleanup() const;
 
     CXXCompileAction() = default;
@@ -105,6 +160,11 @@ struct CXXCompileAction {  // NOLINT
             cxx_args     = other.cxx_args;
             flags        = other.flags;
             cxx_compiler = other.cxx_compiler;
+            source_map   = other.source_map;
+            parts        = other.parts;
+            jobs         = other.jobs;
+            cc_text      = other.cc_text;
+            profile      = other.profile;
         }
         return *this;
     }
@@ -116,7 +176,12 @@ struct CXXCompileAction {  // NOLINT
         , helix_src(std::move(other.helix_src))
         , cxx_args(std::move(other.cxx_args))
         , flags(other.flags)
-        , cxx_compiler(std::move(other.cxx_compiler)) {}
+        , cxx_compiler(std::move(other.cxx_compiler))
+        , source_map(std::move(other.source_map))
+        , parts(std::move(other.parts))
+        , cc_text(std::move(other.cc_text))
+        , jobs(other.jobs)
+        , profile(other.profile) {}
 
     CXXCompileAction &operator=(CXXCompileAction &&other) noexcept {
         if (this != &other) {
@@ -127,6 +192,11 @@ struct CXXCompileAction {  // NOLINT
             cxx_args     = std::move(other.cxx_args);
             flags        = other.flags;
             cxx_compiler = std::move(other.cxx_compiler);
+            source_map   = std::move(other.source_map);
+            parts        = std::move(other.parts);
+            jobs         = other.jobs;
+            cc_text      = std::move(other.cc_text);
+            profile      = other.profile;
         }
         return *this;
     }
@@ -137,6 +207,21 @@ struct CXXCompileAction {  // NOLINT
     static std::string generate_file_name(size_t length = 6);
 };
 
+/// what the driver knows about a c++ compiler. probed once per executable and kept between runs,
+/// so a build does not start by asking the compiler who it is
+struct Toolchain {
+    flag::types::Compiler kind = flag::types::Compiler::Custom;
+    std::string           version;  // `--version`, part of every cache key the compiler affects
+
+    bool pch = false;  // builds precompiled headers, see `core_include`
+    bool lto = false;  // compiles and links with -flto
+    bool lld = false;  // links with -fuse-ld=lld
+
+    /// \returns what `compiler` supports, nullopt if it does not run. probed again whenever the
+    /// executable it resolves to changes
+    [[nodiscard]] static std::optional<Toolchain> probe(const std::string &compiler);
+};
+
 class CXIRCompiler {
   public:
     struct ExecResult {
@@ -146,22 +231,131 @@ class CXIRCompiler {
 
     using CompileResult = std::pair<ExecResult, flag::ErrorType>;
 
-    [[nodiscard]] static ExecResult exec(const std::string &cmd);
+    /// called with each line of output (without its newline) while the command still runs
+    using LineCallback = std::function<void(std::string_view)>;
+
+    /// runs `cmd` without a shell unless it needs one, `2>&1` merges stderr into the output
+    /// \param input written to its stdin while it runs, stdin is empty when null
+    [[nodiscard]] static ExecResult exec(const std::string  &cmd,
+                                         const LineCallback &on_line = {},
+                                         const std::string  *input   = nullptr);
+
+    /// runs `cmds` with at most `jobs` of them at once, 0 for one per hardware thread
+    /// \param on_line called from every job at once, see `exec`
+    /// \param inputs the stdin of each command if not empty, see `exec`
+    /// \returns the result of each command, in the order of `cmds`
+    [[nodiscard]] static std::vector<ExecResult>
+    exec_all(const std::vector<std::string>         &cmds,
+             size_t                                  jobs,
+             const LineCallback                     &on_line = {},
+             const std::vector<const std::string *> &inputs  = {});
 
     void compile_CXIR(CXXCompileAction &&action, bool dry_run = false) const;
 
   private:
     mutable bool dry_run = false;
-    /// (pof, msg, file)
-    using ErrorPOFNormalized = std::tuple<token::Token, std::string, std::string>;
+
+    /// appends `data` to `pending` and hands every line it completes to `on_line`
+    static void split_lines(std::string        &pending,
+                            std::string_view    data,
+                            const LineCallback &on_line);
+    /// (pof, msg, file, column as reported, 0 if it was not)
+    using ErrorPOFNormalized = std::tuple<token::Token, std::string, std::string, size_t>;
 
     [[nodiscard]] static ErrorPOFNormalized parse_clang_err(std::string clang_out);
     [[nodiscard]] static ErrorPOFNormalized parse_gcc_err(std::string gcc_out);
     [[nodiscard]] static ErrorPOFNormalized parse_msvc_err(std::string msvc_out);
 
+    /// points `err` at the helix source when it points into the generated c++ itself
+    /// \param line_starts offsets of the lines of each generated c++ file, filled on first use
+    /// \returns false if `err` is left as it was
+    static bool remap_err(ErrorPOFNormalized                          &err,
+                          const CXXCompileAction                      &action,
+                          std::map<std::string, std::vector<size_t>> &line_starts);
+
+    /// \returns a hash of every file the installed core is made of, by path, size and mtime
+    [[nodiscard]] static std::optional<u64> core_version(const std::filesystem::path &core);
+
+    /// \returns the flags that force include the core runtime. with clang or gcc that is a
+    /// precompiled `core.h` out of a cache keyed on the compiler, `language_flags` and the
+    /// installed core, built the first time the key is seen. falls back to the plain header
+    [[nodiscard]] static std::string core_include(const CXXCompileAction      &action,
+                                                  const Toolchain             &toolchain,
+                                                  const std::filesystem::path &core,
+                                                  const std::string           &language_flags);
+
+    /// \returns the -fprofile-generate or -fprofile-use flags for `action.profile`, empty when
+    /// neither is used or the profile can not be. a profile directory is stamped with a hash of
+    /// the cx-ir it was recorded for, a profile stamped for other cx-ir is stale and left out.
+    /// clang's raw profiles are merged with llvm-profdata first
+    [[nodiscard]] static std::string pgo_flags(const CXXCompileAction &action,
+                                               const Toolchain        &toolchain);
+
     [[nodiscard]] CompileResult CXIR_MSVC(const CXXCompileAction &action) const;
 
     [[nodiscard]] CompileResult CXIR_CXX(const CXXCompileAction &action) const;
+
+    /// compiles `action.cc_text` with the clang linked into helix, only linking is left to the
+    /// system compiler. NotFound when the clang resource directory is not installed
+    [[nodiscard]] CompileResult CXIR_CLANG(const CXXCompileAction &action) const;
+
+    /// shows `err` as a helix diagnostic, its message is `<level>: <text>`
+    static void show_err(ErrorPOFNormalized &err);
+};
+
+/// the per user directory the driver keeps its caches in, and how files get into it. it is never
+/// shared with other users, everything in it is linked into or trusted by their builds
+class BuildCache {
+  public:
+    /// \returns `<user cache>/helix/<name>` ($XDG_CACHE_HOME, ~/.cache or %LOCALAPPDATA%),
+    /// created private to this user. nullopt if it can not be created or another user owns it
+    [[nodiscard]] static std::optional<std::filesystem::path> dir(std::string_view name);
+
+    /// \returns a name next to `path` that no other thread or process uses, to write `path` under
+    [[nodiscard]] static std::filesystem::path scratch(const std::filesystem::path &path);
+
+    /// renames the complete `tmp` over `path` so no reader ever sees it half written, `tmp` is
+    /// removed if that fails. \returns false on failure
+    static bool publish(const std::filesystem::path &tmp, const std::filesystem::path &path);
+};
+
+/// objects compiled from cx-ir, kept between builds under a key covering everything that went
+/// into them. least recently used objects are dropped once the cache outgrows `LIMIT`
+class ObjectCache {
+  public:
+    static constexpr uintmax_t LIMIT = uintmax_t{2} << 30;  // 2 GiB
+
+    /// \returns where the object for `key` is kept, nullopt if the cache can not be used
+    [[nodiscard]] static std::optional<std::filesystem::path> find(u64 key);
+
+    /// marks `cached` as just used, \returns false if it is not in the cache
+    static bool touch(const std::filesystem::path &cached);
+
+    /// copies the freshly compiled `object` to `cached`, failures are ignored (it is a cache)
+    static void store(const std::filesystem::path &object, const std::filesystem::path &cached);
+
+    /// drops the least recently used objects until the cache is well under `LIMIT`
+    static void trim();
+};
+
+/// parsed modules kept between builds as ast snapshots, one per module and include path so a
+/// module parsed again overwrites its old snapshot. a snapshot is only used while the helix that
+/// wrote it and every file it was parsed from are unchanged
+class AstCache {
+  public:
+    /// \returns where the snapshot of the module `parsed_args.file` is kept, nullopt if the cache
+    /// is off for this build or can not be used
+    [[nodiscard]] static std::optional<std::filesystem::path>
+    find(const __CONTROLLER_CLI_N::CLIArgs &parsed_args);
+
+    /// \returns a hash of the running helix, a snapshot another build of it wrote is not used
+    [[nodiscard]] static u64 stamp();
+
+    /// \returns a hash of the contents of `file`, nullopt if it can not be read
+    [[nodiscard]] static std::optional<u64> hash(const std::filesystem::path &file);
+
+    /// writes `snapshot` to `cached`, failures are ignored (it is a cache)
+    static void store(const std::string &snapshot, const std::filesystem::path &cached);
 };
 
 class CompilationUnit {
@@ -178,9 +372,20 @@ class CompilationUnit {
     CXIRCompiler                                           compiler;
     __AST_N::NodeT<__AST_NODE::Program>                    ast;
     std::shared_ptr<parser::preprocessor::ImportProcessor> import_processor = nullptr;
+    std::shared_ptr<const generator::CXIR::CXIR>           lowered = nullptr;  // imported modules
 
     static void remove_comments(__TOKEN_N::TokenList &tokens);
 
+    /// takes the ast and the imports of the module `parsed_args.file` from the snapshot at
+    /// `cached`. \returns false if it is stale or unreadable, nothing is changed then
+    bool restore(__CONTROLLER_CLI_N::CLIArgs &parsed_args, const std::filesystem::path &cached);
+
+    /// writes the ast just parsed to `cached`, to be restored by the next build while `sources`
+    /// (the files its tokens came from) and the modules it imports are unchanged
+    void snapshot(const __CONTROLLER_CLI_N::CLIArgs &parsed_args,
+                  const std::vector<std::string>    &sources,
+                  const std::filesystem::path       &cached) const;
+
     static void emit_cxir(const generator::CXIR::CXIR &emitter, bool verbose);
 
     static std::filesystem::path
@@ -15,15 +15,88 @@
 
 #include "controller/include/cli/cli.hh"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "neo-pprint/include/ansi_colors.hh"
 #include "neo-pprint/include/hxpprint.hh"
 #include "taywee-args/include/args.hh"
 
 __CONTROLLER_CLI_BEGIN {
+    namespace {
+        std::optional<CLIArgs::PROFILE> parse_profile(std::string_view name) {
+            if (name == "dev") {
+                return CLIArgs::PROFILE::DEV;
+            }
+            if (name == "release") {
+                return CLIArgs::PROFILE::RELEASE;
+            }
+            if (name == "max") {
+                return CLIArgs::PROFILE::MAX;
+            }
+            if (name == "size") {
+                return CLIArgs::PROFILE::SIZE;
+            }
+
+            return std::nullopt;
+        }
+
+        std::string_view trim(std::string_view str) {
+            const size_t start = str.find_first_not_of(" \t\r");
+            const size_t end   = str.find_last_not_of(" \t\r");
+
+            return start == std::string_view::npos ? std::string_view()
+                                                   : str.substr(start, end - start + 1);
+        }
+
+        /// reads `profile = "<name>"` out of the top level or the `[build]` table of a
+        /// `helix.toml`, nothing else in it is used yet
+        /// \returns the profile name, an empty string if the file does not set one and nullopt if
+        /// it can not be read
+        std::optional<std::string> read_config_profile(const std::string &path) {
+            std::ifstream file(path);
+
+            if (!file) {
+                return std::nullopt;
+            }
+
+            std::string line;
+            std::string table;
+            std::string profile;
+
+            while (std::getline(file, line)) {
+                std::string_view entry = trim(std::string_view(line).substr(0, line.find('#')));
+
+                if (entry.starts_with('[') && entry.ends_with(']')) {
+                    table = trim(entry.substr(1, entry.size() - 2));
+                    continue;
+                }
+
+                const size_t eq = entry.find('=');
+
+                if (eq == std::string_view::npos || trim(entry.substr(0, eq)) != "profile" ||
+                    (!table.empty() && table != "build")) {
+                    continue;
+                }
+
+                std::string_view value = trim(entry.substr(eq + 1));
+
+                if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') &&
+                    value.back() == value.front()) {
+                    value = value.substr(1, value.size() - 2);
+                }
+
+                profile = value;
+            }
+
+            return profile;
+        }
+    }  // namespace
+
     CLIArgs::CLIArgs(int argc, char **argv, const std::string &_version) {
         args::ArgumentParser parser("Helix Compiler Command Line Interface", R"(
 Helix CLI - The Next-Generation Compiler for Modern Development
@@ -70,6 +143,10 @@ DISCLAIMER: All of these options are subject to change in future versions of hel
         args::Flag emit_asm(parser, "emit-asm", "Output assembly code", {"emit-asm"});
         args::Flag emit_ast(
             parser, "emit-ast", "Output Abstract Syntax Tree (AST) in JSON format", {"emit-ast"});
+        args::Flag emit_ast_beve(parser,
+                                 "emit-ast-beve",
+                                 "Output Abstract Syntax Tree (AST) in binary (BEVE) format",
+                                 {"emit-ast-beve"});
         args::Flag emit_cst(
             parser, "emit-cst", "Output Concrete Syntax Tree (CST) in JSON format", {"emit-cst"});
         args::Flag emit_ir(
@@ -84,8 +161,9 @@ DISCLAIMER: All of these options are subject to change in future versions of hel
         args::ValueFlag<std::string> toolchain_target(
             parser, "target", "Specify target triple for cross-compilation", {"target"});
         args::ValueFlag<std::string> toolchain_arch(
-            parser, "arch", "Specify target architecture", {"arch"});
-        args::ValueFlag<std::string> toolchain_cpu(parser, "cpu", "Specify target MCPU", {"cpu"});
+            parser, "arch", "Specify target instruction set (-march), or native", {"arch"});
+        args::ValueFlag<std::string> toolchain_cpu(
+            parser, "cpu", "Specify target CPU (-mtune, -mcpu outside x86), or native", {"cpu"});
         args::ValueFlag<std::string> toolchain_sdk(
             parser, "sdk", "Specify optional path to SDK", {"sdk"});
 
@@ -94,6 +172,23 @@ DISCLAIMER: All of these options are subject to change in future versions of hel
         args::ValueFlag<std::string> output_file(
             parser, "output", "Specify output file path", {'o'});
 
+        args::ValueFlag<std::string> profile(
+            parser,
+            "profile",
+            "Build profile: dev (fast builds), release (default), max (fastest code) or size",
+            {"profile"});
+
+        args::Flag profile_generate(
+            parser,
+            "profile-generate",
+            "Build an instrumented binary, running it records a profile to <output>.profile",
+            {"profile-generate"});
+        args::ValueFlag<std::string> profile_use(
+            parser,
+            "dir",
+            "Optimize with the profile recorded by a --profile-generate build",
+            {"profile-use"});
+
         args::Flag release(
             parser, "release", "Build in release mode with optimizations", {'r', "release"});
         args::Flag debug(
@@ -114,6 +209,27 @@ DISCLAIMER: All of these options are subject to change in future versions of hel
 
         args::Flag lib(parser, "lib", "Compile as a library", {"lib"});
 
+        args::ValueFlag<size_t> split_units(
+            parser,
+            "units",
+            "Split the generated C++ into up to <units> translation units compiled in parallel",
+            {"split"});
+        args::ValueFlag<size_t> jobs(
+            parser, "jobs", "Number of C++ compiler processes to run at once (0: one per core)",
+            {'j', "jobs"});
+        args::Flag in_process(parser,
+                              "in-process",
+                              "Compile the generated C++ with the built-in clang",
+                              {"in-process"});
+        args::Flag no_cache(parser,
+                            "no-cache",
+                            "Always run the C++ compiler, ignoring previously compiled objects",
+                            {"no-cache"});
+        args::Flag pipe(parser,
+                        "pipe",
+                        "Feed the generated C++ to the C++ compiler on stdin, not a temporary file",
+                        {"pipe"});
+
         args::Group abi_group(parser, "ABI Options", args::Group::Validators::AtMostOne);
         args::Flag  python_abi(abi_group,
                               "python",
@@ -207,18 +323,33 @@ https://helix-lang.com/ for more information.
                 optimize = OPTIMIZATION::O5;
             }
 
-            this->help        = help;
-            this->verbose     = verbose;
-            this->quiet       = quiet;
-            this->error       = error;
-            this->emit_tokens = emit_tokens;
-            this->emit_llvm   = emit_llvm;
-            this->lsp_mode    = lsp_mode;
-            this->emit_asm    = emit_asm;
-            this->emit_ast    = emit_ast;
-            this->emit_cst    = emit_cst;
-            this->emit_ir     = emit_ir;
-            this->emit_doc    = emit_doc;
+            this->help          = help;
+            this->verbose       = verbose;
+            this->quiet         = quiet;
+            this->error         = error;
+            this->emit_tokens   = emit_tokens;
+            this->emit_llvm     = emit_llvm;
+            this->lsp_mode      = lsp_mode;
+            this->emit_asm      = emit_asm;
+            this->emit_ast      = emit_ast;
+            this->emit_ast_beve = emit_ast_beve;
+            this->emit_cst      = emit_cst;
+            this->emit_ir       = emit_ir;
+            this->emit_doc      = emit_doc;
+            this->in_process    = in_process;
+            this->no_cache      = no_cache;
+            this->pipe          = pipe;
+
+            if (profile_generate && profile_use) {
+                print_err(colors::fg16::red, "Error:", colors::reset
+                        , " Cannot specify both --profile-generate and --profile-use.");
+                this->exit_   = true;
+                this->exit_co = 1;
+                return;
+            }
+
+            this->profile_generate = profile_generate;
+            this->profile_use      = profile_use ? args::get(profile_use) : std::string();
             
 
             if (verbose && quiet) {
@@ -265,6 +396,45 @@ https://helix-lang.com/ for more information.
                 this->config_file = args::get(config_file);
             }
 
+            /// the command line wins over the config file
+            std::string profile_name = profile ? args::get(profile) : std::string();
+
+            if (!profile && !this->config_file.empty()) {
+                std::optional<std::string> configured = read_config_profile(this->config_file);
+
+                if (!configured.has_value()) {
+                    print_err(colors::fg16::red, "Error:", colors::reset
+                            , " Cannot read the configuration file \"", this->config_file, "\".");
+                    this->exit_   = true;
+                    this->exit_co = 1;
+                    return;
+                }
+
+                profile_name = *configured;
+            }
+
+            if (!profile_name.empty()) {
+                std::optional<PROFILE> parsed = parse_profile(profile_name);
+
+                if (!parsed.has_value()) {
+                    print_err(colors::fg16::red, "Error:", colors::reset
+                            , " Unknown profile \"", profile_name
+                            , "\", expected one of dev, release, max or size.");
+                    this->exit_   = true;
+                    this->exit_co = 1;
+                    return;
+                }
+
+                this->profile = *parsed;
+            }
+
+            if (split_units) {
+                this->split_units = std::max<size_t>(args::get(split_units), 1);
+            }
+            if (jobs) {
+                this->jobs = args::get(jobs);
+            }
+
             this->include_dirs   = args::get(include_dirs);
             this->library_dirs   = args::get(library_dirs);
             this->link_libraries = args::get(link_libraries);
@@ -283,6 +453,8 @@ https://helix-lang.com/ for more information.
                 "    emit asm: " + std::to_string(static_cast<int>(emit_asm)) + ", \n";
             this->get_all_flags +=
                 "    emit ast: " + std::to_string(static_cast<int>(emit_ast)) + ", \n";
+            this->get_all_flags +=
+                "    emit ast beve: " + std::to_string(static_cast<int>(emit_ast_beve)) + ", \n";
             this->get_all_flags +=
                 "    emit cst: " + std::to_string(static_cast<int>(emit_cst)) + ", \n";
             this->get_all_flags +=
@@ -308,6 +480,17 @@ https://helix-lang.com/ for more information.
             this->get_all_flags += "    toolchain arch: " + toolchain_arch.Get() + ", \n";
             this->get_all_flags += "    toolchain cpu: " + toolchain_cpu.Get() + ", \n";
             this->get_all_flags += "    toolchain sdk: " + toolchain_sdk.Get() + ", \n";
+            this->get_all_flags += "    profile: " + profile_name + ", \n";
+            this->get_all_flags += "    profile generate: " +
+                                   std::to_string(static_cast<int>(profile_generate)) + ", \n";
+            this->get_all_flags += "    profile use: " + profile_use.Get() + ", \n";
+            this->get_all_flags += "    split: " + std::to_string(this->split_units) + ", \n";
+            this->get_all_flags += "    jobs: " + std::to_string(this->jobs) + ", \n";
+            this->get_all_flags +=
+                "    in process: " + std::to_string(static_cast<int>(in_process)) + ", \n";
+            this->get_all_flags +=
+                "    no cache: " + std::to_string(static_cast<int>(no_cache)) + ", \n";
+            this->get_all_flags += "    pipe: " + std::to_string(static_cast<int>(pipe)) + ", \n";
 
             this->get_all_flags +=
                 "    include dir: [" + std::string(!include_dirs.Get().empty() ? "\n" : " ");
@@ -0,0 +1,106 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/fingerprint.hh"
+#include "controller/include/tooling/tooling.hh"
+
+namespace {
+constexpr u64 AST_CACHE_VERSION = 1;  // bump when what goes into a key changes
+}  // namespace
+
+std::optional<std::filesystem::path>
+AstCache::find(const __CONTROLLER_CLI_N::CLIArgs &parsed_args) {
+    // a restored module is never lexed, so there are no tokens to emit and no ast to stream
+    if (parsed_args.no_cache || parsed_args.emit_tokens || parsed_args.emit_ast ||
+        parsed_args.emit_ast_beve || parsed_args.lsp_mode) {
+        return std::nullopt;
+    }
+
+    const std::optional<std::filesystem::path> dir = BuildCache::dir("ast");
+
+    if (!dir.has_value()) {
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    Fingerprint     key;
+
+    // not keyed on the contents or on helix itself, a stale snapshot is overwritten in place
+    // instead of piling up next to the new one. `restore` checks both before using it
+    key.add(AST_CACHE_VERSION)
+        .add(std::filesystem::weakly_canonical(parsed_args.file, ec).generic_string())
+        .add(__CONTROLLER_FS_N::get_cwd());
+
+    for (const auto &include : parsed_args.include_dirs) {
+        key.add(include);
+    }
+
+    return *dir / (key.hex() + ".hxast");
+}
+
+u64 AstCache::stamp() {
+    static const u64 stamp = [] {
+        const std::filesystem::path exe = __CONTROLLER_FS_N::get_exe();
+        std::error_code             ec;
+
+        const auto size  = std::filesystem::file_size(exe, ec);
+        const auto mtime = std::filesystem::last_write_time(exe, ec).time_since_epoch().count();
+
+        return Fingerprint().add(exe.generic_string()).add(size).add(mtime).value();
+    }();
+
+    return stamp;
+}
+
+std::optional<u64> AstCache::hash(const std::filesystem::path &file) {
+    std::ifstream             in(file, std::ios::binary);
+    std::array<char, 1 << 16> buffer{};
+    Fingerprint               hash;
+
+    if (!in) {
+        return std::nullopt;
+    }
+
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+        hash.add(buffer.data(), static_cast<size_t>(in.gcount()));
+    }
+
+    return in.bad() ? std::nullopt : std::optional(hash.value());
+}
+
+void AstCache::store(const std::string &snapshot, const std::filesystem::path &cached) {
+    std::error_code             ec;
+    const std::filesystem::path tmp = BuildCache::scratch(cached);
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+
+        if (!out.flush()) {
+            out.close();
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+
+    BuildCache::publish(tmp, cached);
+}
@@ -0,0 +1,134 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "controller/include/tooling/tooling.hh"
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace {
+/// \returns the directory this user's caches go in, nullopt if there is none
+std::optional<std::filesystem::path> user_root() {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    const char *local = std::getenv("LOCALAPPDATA");
+
+    if (local == nullptr || *local == '\0') {
+        return std::nullopt;
+    }
+
+    return std::filesystem::path(local) / "helix";
+#else
+    // a relative $XDG_CACHE_HOME is invalid and ignored, as the spec says
+    const char *xdg = std::getenv("XDG_CACHE_HOME");
+
+    if (xdg != nullptr && xdg[0] == '/') {
+        return std::filesystem::path(xdg) / "helix";
+    }
+
+    const char *home = std::getenv("HOME");
+
+    if (home == nullptr || home[0] != '/') {
+        return std::nullopt;
+    }
+
+    return std::filesystem::path(home) / ".cache" / "helix";
+#endif
+}
+
+/// creates `dir` (its parent has to exist) private to this user
+/// \returns false if it is not a directory this user owns, a symlink is not followed
+bool make_private(const std::filesystem::path &dir) {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    // %LOCALAPPDATA% is only open to its user to begin with
+    std::error_code ec;
+    std::filesystem::create_directory(dir, ec);
+
+    return !ec && !std::filesystem::is_symlink(dir, ec) && std::filesystem::is_directory(dir, ec);
+#else
+    if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+        return false;
+    }
+
+    struct stat info {};
+
+    if (lstat(dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode) || info.st_uid != geteuid()) {
+        return false;
+    }
+
+    return (info.st_mode & 077) == 0 || chmod(dir.c_str(), 0700) == 0;
+#endif
+}
+}  // namespace
+
+std::optional<std::filesystem::path> BuildCache::dir(std::string_view name) {
+    const std::optional<std::filesystem::path> root = user_root();
+    std::error_code                            ec;
+
+    if (!root.has_value()) {
+        return std::nullopt;
+    }
+
+    // ~/.cache and the like are the user's own, only what helix creates in it is checked
+    std::filesystem::create_directories(root->parent_path(), ec);
+
+    if (ec || !make_private(*root) || !make_private(*root / name)) {
+        return std::nullopt;
+    }
+
+    return *root / name;
+}
+
+std::filesystem::path BuildCache::scratch(const std::filesystem::path &path) {
+    thread_local std::mt19937_64 random(std::random_device{}());
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    const auto pid = _getpid();
+#else
+    const auto pid = getpid();
+#endif
+
+    // the pid keeps processes apart, the random part threads and reused pids
+    std::filesystem::path tmp = path;
+    tmp += ".tmp" + std::to_string(pid) + "-" + std::to_string(random());
+
+    return tmp;
+}
+
+bool BuildCache::publish(const std::filesystem::path &tmp, const std::filesystem::path &path) {
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+
+    if (ec) {
+        std::error_code ignored;
+        std::filesystem::remove(tmp, ignored);
+
+        return false;
+    }
+
+    return true;
+}
@@ -20,8 +20,11 @@
 #include <memory>
 #include <neo-panic/include/error.hh>
 #include <neo-pprint/include/hxpprint.hh>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "controller/include/Controller.hh"
@@ -32,7 +35,9 @@
 #include "generator/include/CX-IR/CXIR.hh"
 #include "lexer/include/lexer.hh"
 #include "parser/ast/include/private/base/AST_base.hh"
+#include "parser/ast/include/types/AST_const_fold_visitor.hh"
 #include "parser/ast/include/types/AST_jsonify_visitor.hh"
+#include "parser/ast/include/types/AST_snapshot.hh"
 #include "parser/ast/include/types/AST_types.hh"
 #include "parser/preprocessor/include/preprocessor.hh"
 #include "token/include/private/Token_base.hh"
@@ -217,12 +222,37 @@ std::pair<CXXCompileAction, int> CompilationUnit::build_unit(
     VERBOSE_LOG(parsed_args.get_all_flags);
 
     std::filesystem::path in_file_path = __CONTROLLER_FS_N::normalize_path(parsed_args.file);
-    __TOKEN_N::TokenList  tokens       = pre_process(parsed_args, enable_logging);
+
+    // an imported module nothing has changed under since it was last parsed is neither lexed nor
+    // parsed again, its ast comes out of the snapshot the last parse left
+    const std::optional<std::filesystem::path> cached =
+        no_unit ? AstCache::find(parsed_args) : std::nullopt;
+
+    if (cached.has_value() && restore(parsed_args, *cached)) {
+        helix::log_opt<LogLevel::Progress>(parsed_args.verbose, "restored ast");
+        return {{}, 0};
+    }
+
+    const size_t         reported = error::ERRORS.size();
+    __TOKEN_N::TokenList tokens   = pre_process(parsed_args, enable_logging);
 
     if (tokens.empty()) {
         return {{}, 1};
     }
 
+    // collected before the parser drops the comments, a file of only comments is still a source
+    std::vector<std::string> sources;
+
+    if (cached.has_value()) {
+        std::unordered_set<std::string> seen;
+
+        for (auto &token : tokens) {
+            if (seen.insert(token->get_file_name()).second) {
+                sources.push_back(token->get_file_name());
+            }
+        }
+    }
+
     helix::log_opt<LogLevel::Progress>(parsed_args.verbose, "parsing ast...");
     
     ast = parse_ast(tokens, in_file_path);
@@ -233,16 +263,37 @@ std::pair<CXXCompileAction, int> CompilationUnit::build_unit(
         return {{}, 1};
     }
 
-    if (parsed_args.emit_ast) {
-        __AST_VISITOR::Jsonify json_visitor;
+    // a module that reported anything is parsed again, a restored one would not report it
+    if (cached.has_value() && !ast->has_errored && !error::HAS_ERRORED &&
+        error::ERRORS.size() == reported) {
+        snapshot(parsed_args, sources, *cached);
+    }
+
+    if (parsed_args.emit_ast || parsed_args.emit_ast_beve) {
+        // lsp and beve output is streamed straight to stdout, the debug log needs the whole string
+        const bool stream = parsed_args.lsp_mode || parsed_args.emit_ast_beve;
+
+        __AST_VISITOR::JsonWriter writer(parsed_args.emit_ast_beve ? __AST_VISITOR::JsonFormat::BEVE
+                                                                   : __AST_VISITOR::JsonFormat::JSON,
+                                         stream ? stdout : nullptr);
+        __AST_VISITOR::Jsonify    json_visitor(writer);
+
+        writer.begin_object();
+        writer.key("ast");
         ast->accept(json_visitor);
+        writer.end_object();
+
+        if (stream) {
+            writer.flush();
+
+            if (!parsed_args.emit_ast_beve) {
+                std::fputc('\n', stdout);
+            }
 
-        if (parsed_args.lsp_mode) {
-            print(json_visitor.json.to_string());
             return {{}, 2};
         }
 
-        helix::log<LogLevel::Debug>(json_visitor.json.to_string());
+        helix::log<LogLevel::Debug>(writer.take());
     }
 
     if (error::HAS_ERRORED) {
@@ -277,21 +328,233 @@ std::pair<CXXCompileAction, int> CompilationUnit::build_unit(
         action_flags |= flag::CompileFlags(flag::types::CompileFlags::Verbose);
     }
 
-    return {CXXCompileAction::init(emitter, out_file, action_flags, parsed_args.cxx_args), 0};
+    if (parsed_args.in_process) {
+        action_flags |= flag::CompileFlags(flag::types::CompileFlags::InProcess);
+    }
+
+    if (parsed_args.no_cache) {
+        action_flags |= flag::CompileFlags(flag::types::CompileFlags::NoCache);
+    }
+
+    if (parsed_args.pipe) {
+        action_flags |= flag::CompileFlags(flag::types::CompileFlags::Pipe);
+    }
+
+    if (parsed_args.profile_generate || !parsed_args.profile_use.empty()) {
+        action_flags |= flag::CompileFlags(flag::types::CompileFlags::StableNames);
+    }
+
+    CXXCompileAction action = CXXCompileAction::init(emitter,
+                                                     out_file,
+                                                     action_flags,
+                                                     parsed_args.cxx_args,
+                                                     parsed_args.split_units,
+                                                     parsed_args.jobs);
+
+    action.profile =
+        BuildProfile::of(parsed_args.profile, parsed_args.optimize, parsed_args.toolchain);
+
+    if (parsed_args.profile_generate) {
+        action.profile.profile_generate =
+            std::filesystem::absolute(out_file.generic_string() + ".profile");
+    }
+
+    if (!parsed_args.profile_use.empty()) {
+        action.profile.profile_use = std::filesystem::absolute(parsed_args.profile_use);
+    }
+
+    return {std::move(action), 0};
 }
 
-generator::CXIR::CXIR CompilationUnit::generate_cxir(bool forward_only) {
+bool CompilationUnit::restore(__CONTROLLER_CLI_N::CLIArgs &parsed_args,
+                              const std::filesystem::path &cached) {
+    const __AST_N::SnapshotFile                file(cached);
+    const std::optional<__AST_N::SnapshotView> view = file.view();
+
+    if (!view.has_value() || view->stamp() != AstCache::stamp()) {
+        return false;
+    }
+
+    // the contents decide, a checkout or a touch that changes nothing keeps the snapshot
+    for (u32 index = 0; index < view->dependency_count(); ++index) {
+        const __AST_N::SnapshotView::DependencyRef dependency = view->dependency(index);
+
+        if (AstCache::hash(std::filesystem::path(dependency.path)) != dependency.hash) {
+            return false;
+        }
+    }
 
-    std::vector<generator::CXIR::CXIR> imports;
+    __TOKEN_N::TokenList                tokens;
+    __AST_N::NodeT<__AST_NODE::Program> program = view->load(tokens);
+
+    if (program == nullptr ||
+        program->filename != __CONTROLLER_FS_N::normalize_path(parsed_args.file).generic_string()) {
+        return false;
+    }
+
+    // the imports were resolved when the snapshot was written, only the modules are built again
+    std::vector<std::filesystem::path> import_dirs;
+
+    ast              = std::move(program);
+    import_processor =
+        std::make_shared<__PREPROCESSOR_N::ImportProcessor>(tokens, import_dirs, parsed_args);
+
+    for (u32 index = 0; index < view->import_count(); ++index) {
+        const __AST_N::SnapshotView::ImportRef import = view->import(index);
+        import_processor->reimport(std::string(import.path), import.prune);
+    }
+
+    return true;
+}
+
+void CompilationUnit::snapshot(const __CONTROLLER_CLI_N::CLIArgs &parsed_args,
+                               const std::vector<std::string>    &sources,
+                               const std::filesystem::path       &cached) const {
+    std::vector<__AST_N::Snapshot::Dependency> dependencies;
+    std::vector<__AST_N::Snapshot::Import>     imports;
+    std::unordered_set<std::string>            seen;
+
+    auto depend = [&](const std::string &file) {
+        if (!seen.insert(file).second) {
+            return true;
+        }
 
+        const std::optional<u64> hash = AstCache::hash(file);
+
+        if (hash.has_value()) {
+            dependencies.push_back({file, *hash});
+        }
+
+        return hash.has_value();
+    };
+
+    if (!depend(parsed_args.file)) {
+        return;
+    }
+
+    for (const auto &source : sources) {
+        if (!depend(source)) {
+            return;
+        }
+    }
+
+    // an imported module is a dependency as well, a wildcard import reads it for its directives
     if (import_processor != nullptr) {
-        imports = std::move(import_processor->imports);
+        for (const auto &import : import_processor->imports) {
+            if (!depend(import.file)) {
+                return;
+            }
+
+            imports.push_back({import.file, import.prune});
+        }
+    }
+
+    const std::string bytes =
+        __AST_N::Snapshot::write(*ast, AstCache::stamp(), dependencies, imports);
+
+    if (!bytes.empty()) {
+        AstCache::store(bytes, cached);
+    }
+}
+
+/// lowers this unit together with every module it imports, directly or not. a module reached
+/// along several import paths is pruned and lowered once, keeping what any of its importers
+/// reach, and its cx-ir is shared by all of them
+generator::CXIR::CXIR CompilationUnit::generate_cxir(bool forward_only) {
+    using Imports = std::vector<parser::preprocessor::ImportProcessor::Import>;
+
+    /// what the importers of a module reach in it
+    struct Roots {
+        __AST_VISITOR::NameSet names;
+        bool                   everything = false;  // an importer keeps all of it
+    };
+
+    static const Imports no_imports;
+
+    auto imports_of = [](const CompilationUnit *unit) -> const Imports & {
+        return unit->import_processor != nullptr ? unit->import_processor->imports : no_imports;
+    };
+
+    std::vector<CompilationUnit *>               postorder;  // each module after what it imports
+    std::unordered_map<CompilationUnit *, bool>  walked;     // false while its imports are walked
+    std::unordered_map<CompilationUnit *, Roots> roots;
+
+    auto walk = [&](auto &self, CompilationUnit *unit) -> void {
+        if (unit->lowered != nullptr) {  // pruned against its importers and lowered already
+            return;
+        }
+
+        if (auto found = walked.find(unit); found != walked.end()) {
+            // an import cycle, not every importer of it is known before it is pruned
+            if (!found->second) {
+                roots[unit].everything = true;
+            }
+
+            return;
+        }
+
+        walked[unit] = false;
+
+        for (const auto &import : imports_of(unit)) {
+            self(self, import.unit.get());
+        }
+
+        walked[unit] = true;
+        postorder.push_back(unit);
+    };
+
+    walk(walk, this);
+    roots[this].everything = true;
+
+    // importers come before what they import, so every root of a module is known once it is up
+    for (auto unit = postorder.rbegin(); unit != postorder.rend(); ++unit) {
+        const __AST_N::NodeT<__AST_NODE::Program> &program = (*unit)->ast;
+
+        // fold literal only expressions so cx-ir (and clang) never sees them
+        __AST_VISITOR::ConstFold folder;
+        program->accept(folder);
+
+        // drop what no importer reaches, whatever is left decides what our own imports keep
+        const Roots           &reached = roots[*unit];
+        __AST_VISITOR::NameSet used    = reached.everything
+                                             ? __AST_VISITOR::references(*program)
+                                             : __AST_VISITOR::prune_unreachable(*program,
+                                                                                reached.names);
+
+        for (const auto &import : imports_of(*unit)) {
+            Roots &next = roots[import.unit.get()];
+
+            if (import.prune) {
+                next.names.insert(used.begin(), used.end());
+            } else {
+                next.everything = true;
+            }
+        }
     }
 
-    generator::CXIR::CXIR emitter(forward_only, std::move(imports));
+    auto lower = [&](CompilationUnit *unit) {
+        std::vector<std::shared_ptr<const generator::CXIR::CXIR>> imports;
+
+        for (const auto &import : imports_of(unit)) {
+            // a module an import cycle leads back to is not lowered yet, it is left out here
+            if (import.unit->lowered != nullptr) {
+                imports.push_back(import.unit->lowered);
+            }
+        }
+
+        generator::CXIR::CXIR emitter(unit == this && forward_only, std::move(imports));
+        unit->ast->accept(emitter);
+
+        return emitter;
+    };
+
+    postorder.pop_back();  // this unit itself, the only one not kept for importers
+
+    for (CompilationUnit *unit : postorder) {
+        unit->lowered = std::make_shared<const generator::CXIR::CXIR>(lower(unit));
+    }
 
-    ast->accept(emitter);
-    return emitter;
+    return lower(this);
 }
 
 int CompilationUnit::compile(__CONTROLLER_CLI_N::CLIArgs &parsed_args) {
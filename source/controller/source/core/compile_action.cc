@@ -13,10 +13,13 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <neo-panic/include/error.hh>
 #include <neo-pprint/include/hxpprint.hh>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <string>
@@ -25,6 +28,7 @@
 #include "controller/include/config/Controller_config.def"
 #include "controller/include/shared/eflags.hh"
 #include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/fingerprint.hh"
 #include "controller/include/shared/logger.hh"
 #include "controller/include/tooling/tooling.hh"
 
@@ -35,8 +39,95 @@
     }
 #endif
 
-CXXCompileAction
-CXXCompileAction::init(CXIR &emitter, const Path &cc_out, flag::CompileFlags flags, Args cxx_args) {
+BuildProfile BuildProfile::of(__CONTROLLER_CLI_N::CLIArgs::PROFILE                     profile,
+                              std::optional<__CONTROLLER_CLI_N::CLIArgs::OPTIMIZATION> level,
+                              const __CONTROLLER_CLI_N::CLIArgs::tool_chain           &toolchain) {
+    using PROFILE = __CONTROLLER_CLI_N::CLIArgs::PROFILE;
+    BuildProfile flags;
+
+    switch (profile) {
+        case PROFILE::DEV:  // iteration speed, the object cache and lld do the rest
+            flags.optimize = cxx::flags::optimizationLevel1;
+            flags.lto      = cxx::flags::None;
+            break;
+        case PROFILE::RELEASE:
+            break;
+        case PROFILE::MAX:  // only runs on the machine (or the same cpu) that built it
+            flags.lto  = cxx::flags::linkTimeOptimizationFlag;
+            flags.arch = "native";
+            break;
+        case PROFILE::SIZE:
+            flags.optimize = cxx::flags::optimizationSize;
+            flags.lto      = cxx::flags::linkTimeOptimizationFlag;
+            break;
+    }
+
+    if (level.has_value()) {
+        switch (*level) {
+            case __CONTROLLER_CLI_N::CLIArgs::OPTIMIZATION::O1:
+                flags.optimize = cxx::flags::optimizationLevel1;
+                break;
+            case __CONTROLLER_CLI_N::CLIArgs::OPTIMIZATION::O2:
+                flags.optimize = cxx::flags::optimizationLevel2;
+                break;
+            default:
+                flags.optimize = cxx::flags::optimizationLevel3;
+                break;
+        }
+    }
+
+    if (!toolchain.arch.empty() || !toolchain.cpu.empty()) {  // a known fleet beats `native`
+        flags.arch = toolchain.arch;
+        flags.cpu  = toolchain.cpu;
+    }
+
+    flags.target = toolchain.target;
+
+    return flags;
+}
+
+std::string BuildProfile::codegen(flag::types::Compiler compiler) const {
+    if (compiler == flag::types::Compiler::MSVC) {  // msvc only has the instruction set
+        return arch.empty() ? std::string() : "/arch:" + arch + " ";
+    }
+
+    std::string flags;
+
+    if (!target.empty() && compiler == flag::types::Compiler::Clang) {  // gcc has one target
+        flags += "--target=" + target + " ";
+    }
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    bool x86 = target.empty();
+#else
+    bool x86 = false;
+#endif
+
+    if (!target.empty()) {
+        x86 = target.starts_with("x86_64") || target.starts_with("amd64") ||
+              (target.size() > 3 && target[0] == 'i' && target.substr(2, 2) == "86");
+    }
+
+    /// on x86 a cpu names an instruction set as well, elsewhere -mcpu is what selects both
+    if (!arch.empty()) {
+        flags += "-march=" + arch + " ";
+    } else if (!cpu.empty() && x86) {
+        flags += "-march=" + cpu + " ";
+    }
+
+    if (!cpu.empty()) {
+        flags += (x86 ? "-mtune=" : "-mcpu=") + cpu + " ";
+    }
+
+    return flags;
+}
+
+CXXCompileAction CXXCompileAction::init(CXIR              &emitter,
+                                        const Path        &cc_out,
+                                        flag::CompileFlags flags,
+                                        Args               cxx_args,
+                                        size_t             units,
+                                        size_t             jobs) {
     std::error_code            ec;
     std::optional<std::string> helix_src = emitter.get_file_name();
     Path                       cwd       = __CONTROLLER_FS_N::get_cwd();
@@ -54,6 +145,14 @@ CXXCompileAction::init(CXIR &emitter, const Path &cc_out, flag::CompileFlags fla
         temp_dir = cwd;
     }
 
+    /// the same helix source gets the same name every build, profiles (and the object files gcc
+    /// names them after) refer to the cx-ir by it
+    if (flags.contains(EFlags(flag::types::CompileFlags::StableNames)) && helix_src.has_value()) {
+        const std::string source = std::filesystem::absolute(*helix_src, ec).generic_string();
+        cc_source = cc_source.parent_path() /
+                    ("__" + Fingerprint().add(source).hex() + ".helix-compiler.cxir");
+    }
+
     if (flags.contains(EFlags(flag::types::CompileFlags::Verbose)) &&
         flags.contains(EFlags(flag::types::CompileFlags::Debug))) {
         cc_source = cwd / "IR.temp.debug.verbose.helix-compiler.cxir";
@@ -75,15 +174,80 @@ CXXCompileAction::init(CXIR &emitter, const Path &cc_out, flag::CompileFlags fla
 #endif
     };
 
-    std::ofstream file(action.cc_source);
+    action.jobs = jobs;
+
+    const bool in_process = flags.contains(EFlags(flag::types::CompileFlags::InProcess));
+    const bool piped      = flags.contains(EFlags(flag::types::CompileFlags::Pipe));
+    const bool keep_maps  = flags.contains(EFlags(flag::types::CompileFlags::Verbose)) &&
+                            flags.contains(EFlags(flag::types::CompileFlags::Debug));
+
+    /// the in process compile takes one buffer, splitting is only done for the system compiler
+    const generator::CXIR::CXIR::Split split =
+        in_process ? generator::CXIR::CXIR::Split{} : emitter.split(units);
+
+    /// streams translation unit `part` (or the whole program when not split) into `path`
+    auto write_unit = [&](const Path &path, u32 part) {
+        std::ofstream file(path);
+
+        if (!file) {
+            helix::log<LogLevel::Error>("error creating ", path.generic_string(), " file");
+            return std::shared_ptr<generator::CXIR::SourceMap>();
+        }
+
+        auto map = std::make_shared<generator::CXIR::SourceMap>();
+
+        {  // stream the cx-ir straight into the file instead of building it in memory first
+            const size_t expected = emitter.estimate_size() / std::max<size_t>(split.parts, 1);
+            generator::CXIR::CXIRWriter out(expected, &file);
+
+            if (split.parts == 0) {
+                emitter.write(out, map.get());
+            } else {
+                emitter.write_part(out, split, part, map.get());
+            }
+        }
+
+        file.close();
+
+        if (keep_maps) {  // kept next to the cx-ir
+            std::ofstream map_file(path.generic_string() + ".map", std::ios::binary);
+            map_file << map->serialize();
+        }
+
+        return map;
+    };
+
+    /// nothing is written, clang reads the cx-ir from memory or the compiler from its stdin. split
+    /// units are files, they are compiled side by side
+    if ((in_process || (piped && split.parts <= 1)) && !keep_maps) {
+        generator::CXIR::CXIRWriter out(emitter.estimate_size());
+
+        action.source_map = std::make_shared<generator::CXIR::SourceMap>();
+        emitter.write(out, action.source_map.get());
+        action.cc_text = std::make_shared<const std::string>(out.take());
+    } else {
+        action.source_map = write_unit(action.cc_source, 0);
+
+        if (action.source_map == nullptr) {
+            return action;
+        }
 
-    if (!file) {
-        helix::log<LogLevel::Error>("error creating ", action.cc_source.generic_string(), " file");
-        return action;
+        if (in_process) {  // kept on disk to debug, compiled the same
+            action.cc_text = std::make_shared<const std::string>(
+                __CONTROLLER_FS_N::read_file(action.cc_source.generic_string()));
+        }
     }
 
-    file << emitter.to_CXIR();
-    file.close();
+    for (u32 part = 1; part < split.parts; ++part) {
+        Path source = action.cc_source.generic_string() + "." + std::to_string(part);
+        auto map    = write_unit(source, part);
+
+        if (map == nullptr) {
+            return action;
+        }
+
+        action.parts.push_back(Part{.cc_source = std::move(source), .source_map = std::move(map)});
+    }
 
     if (flags.contains(EFlags(flag::types::CompileFlags::Verbose))) {
         DEBUG_LOG("CXXCompileAction initialized with:");
@@ -103,6 +267,7 @@ CXXCompileAction::init(CXIR &emitter, const Path &cc_out, flag::CompileFlags fla
                       "]");
         DEBUG_LOG("does cc_source exists? : ",
                   std::filesystem::exists(action.cc_source) ? "yes" : "no");
+        DEBUG_LOG("translation units: ", std::to_string(action.parts.size() + 1));
     }
 
     return action;
@@ -124,6 +289,16 @@ void CXXCompileAction::cleanup() const {
     if (std::filesystem::exists(cc_source)) {
         std::filesystem::remove(cc_source);
     }
+
+    std::error_code ec;
+    std::filesystem::remove(cc_source.generic_string() + ".map", ec);
+    std::filesystem::remove(cc_source.generic_string() + ".o", ec);
+
+    for (const auto &part : parts) {
+        std::filesystem::remove(part.cc_source, ec);
+        std::filesystem::remove(part.cc_source.generic_string() + ".map", ec);
+        std::filesystem::remove(part.cc_source.generic_string() + ".o", ec);
+    }
 #endif
 }
 
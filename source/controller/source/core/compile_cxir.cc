@@ -13,13 +13,39 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "controller/include/config/cxx_flags.hh"
 #include "controller/include/shared/eflags.hh"
+#include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/fingerprint.hh"
 #include "controller/include/shared/logger.hh"
 #include "controller/include/tooling/tooling.hh"
 #include "neo-panic/include/error.hh"
 #include "parser/preprocessor/include/preprocessor.hh"
 
+namespace {
+constexpr u64 OBJECT_CACHE_VERSION = 1;  // bump when what goes into an object changes
+
+/// writes the cx-ir `init` kept in memory out to `cc_source`, for a compiler that reads a file
+void spill(const CXXCompileAction &action) {
+    if (action.cc_text != nullptr && !std::filesystem::exists(action.cc_source)) {
+        std::ofstream(action.cc_source, std::ios::binary) << *action.cc_text;
+    }
+}
+}  // namespace
+
 #ifndef DEBUG_LOG
 #define DEBUG_LOG(...)                            \
     if (is_verbose) {                             \
@@ -30,10 +56,22 @@
 void CXIRCompiler::compile_CXIR(CXXCompileAction &&action, bool dry_run) const {
     this->dry_run = dry_run;
     CompileResult ret;
+
+    if (action.flags.contains(flag::types::CompileFlags::InProcess)) {
+        if (!action.cxx_compiler.empty()) {  // it still links the objects
+            ret = CXIR_CLANG(action);
+
+            if (!ret.second.contains(flag::types::ErrorType::NotFound)) {
+                return;
+            }
+        }
+    }
+
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
     // try compiling with msvc first
     if (action.cxx_compiler.empty()) {
         try {
+            spill(action);  // msvc has no way to read it from stdin
             ret = CXIR_MSVC(action);
 
             if (ret.second.contains(flag::types::ErrorType::NotFound)) {
@@ -61,24 +99,42 @@ void CXIRCompiler::compile_CXIR(CXXCompileAction &&action, bool dry_run) const {
 }
 
 CXIRCompiler::CompileResult CXIRCompiler::CXIR_CXX(const CXXCompileAction &action) const {
-    /// identify the compiler
-    ExecResult            compile_result = exec(action.cxx_compiler + " --version");
-    flag::types::Compiler compiler       = flag::types::Compiler::Custom;
+    /// identify the compiler, only runs it the first time it is seen
+    const std::optional<Toolchain> toolchain = Toolchain::probe(action.cxx_compiler);
+    ExecResult                     compile_result;
     bool is_verbose = action.flags.contains(EFlags(flag::types::CompileFlags::Verbose));
 
-    if (compile_result.return_code != 0) {
+    if (!toolchain.has_value()) {
         helix::log<LogLevel::Error>("failed to identify the compiler");
         return {compile_result, flag::ErrorType(flag::types::ErrorType::NotFound)};
     }
 
-    if (compile_result.output.find("clang") != std::string::npos) {
-        compiler = flag::types::Compiler::Clang;
-    } else if (compile_result.output.find("gcc") != std::string::npos) {
-        compiler = flag::types::Compiler::GCC;
-    } else if (compile_result.output.find("msvc") != std::string::npos) {
-        compiler = flag::types::Compiler::MSVC;
-    } else if (compile_result.output.find("mingw") != std::string::npos) {
-        compiler = flag::types::Compiler::MingW;
+    const flag::types::Compiler compiler = toolchain->kind;
+
+    /// lld is only used with clang, gcc's lto objects need its own linker plugin
+    const cxx::flags::CF linker = toolchain->lld && compiler == flag::types::Compiler::Clang
+                                      ? cxx::flags::lldLinkerFlag
+                                      : cxx::flags::None;
+    const cxx::flags::CF lto = toolchain->lto ? action.profile.lto : cxx::flags::None;
+
+    DEBUG_LOG("compiler: " + toolchain->version.substr(0, toolchain->version.find('\n')));
+
+    /// the cx-ir `init` kept in memory goes to clang or gcc on stdin (`-`), it is only written out
+    /// for any other compiler, split units and profiles, which refer to it by name
+    const bool piped = action.cc_text != nullptr &&
+                       action.flags.contains(flag::types::CompileFlags::Pipe) &&
+                       action.parts.empty() && action.profile.profile_generate.empty() &&
+                       action.profile.profile_use.empty() &&
+                       (compiler == flag::types::Compiler::Clang ||
+                        compiler == flag::types::Compiler::GCC);
+
+    if (!piped) {
+        spill(action);
+    }
+
+    if (!action.profile.target.empty() && compiler != flag::types::Compiler::Clang) {
+        helix::log<LogLevel::Warning>("only clang cross compiles with --target, a cross gcc is "
+                                      "an executable of its own; building for the host instead");
     }
 
     std::string compile_cmd = action.cxx_compiler + " ";
@@ -92,8 +148,8 @@ CXIRCompiler::CompileResult CXIRCompiler::CXIR_CXX(const CXXCompileAction &actio
         return {compile_result, flag::ErrorType(flag::types::ErrorType::NotFound)};
     }
 
-    /// start with flags we know are going to be present
-    compile_cmd += make_command(  // ...
+    /// flags that change how the core parses, a precompiled core is only reused with the same
+    std::string language_flags = make_command(  // ...
         compiler,
 
         // cxx::flags::noDefaultLibrariesFlag,
@@ -102,16 +158,35 @@ CXIRCompiler::CompileResult CXIRCompiler::CXIR_CXX(const CXXCompileAction &actio
         // cxx::flags::noBuiltinIncludesFlag,
         // FIXME: add these later
 
-        "-include \"" + core.generic_string() + "\" ",
+        ((action.flags.contains(flag::types::CompileFlags::Debug)) ? cxx::flags::debugModeFlag
+                                                                   : action.profile.optimize),
 
-        ((action.flags.contains(flag::types::CompileFlags::Debug))
-             ? cxx::flags::debugModeFlag
-             : cxx::flags::optimizationLevel3),
-
-        cxx::flags::cxxStandardFlag,
+        action.profile.codegen(compiler),
         cxx::flags::stdCXX23Flag,
         cxx::flags::enableExceptionsFlag,
         cxx::flags::noOmitFramePointerFlag,
+
+        ((action.flags.contains(flag::types::CompileFlags::Debug))
+             ? cxx::flags::SanitizeFlag
+             : cxx::flags::None));
+
+    for (const auto &flag : action.cxx_args) {  // macros, include paths and code generation
+        if (flag.starts_with("-D") || flag.starts_with("-U") || flag.starts_with("-I") ||
+            flag.starts_with("-f") || flag.starts_with("-m")) {
+            language_flags += flag + " ";
+        }
+    }
+
+    /// instrumentation or a recorded profile, both change what the core compiles to as well
+    const std::string pgo = pgo_flags(action, *toolchain);
+    language_flags += pgo;
+
+    /// start with flags we know are going to be present
+    compile_cmd += core_include(action, *toolchain, core, language_flags);
+    compile_cmd += language_flags;
+    compile_cmd += make_command(  // ...
+        compiler,
+        cxx::flags::cxxStandardFlag,
         cxx::flags::noColorDiagnosticsFlag,
         cxx::flags::noDiagnosticsFixitFlag,
         cxx::flags::fullFilePathFlag,
@@ -119,127 +194,253 @@ CXIRCompiler::CompileResult CXIRCompiler::CXIR_CXX(const CXXCompileAction &actio
         cxx::flags::noDiagnosticsShowOptionFlag,
         cxx::flags::caretDiagnosticsMaxLinesFlag,
         cxx::flags::noElideTypeFlag,
-        cxx::flags::linkTimeOptimizationFlag,
-
-        ((action.flags.contains(flag::types::CompileFlags::Debug))
-             ? cxx::flags::SanitizeFlag
-             : cxx::flags::None),
+        lto,
 
 // #if defined(__unix__) || defined(__APPLE__) || defined(__linux__) || defined(__FreeBSD__) ||      \
 //     defined(__NetBSD__) || defined(__OpenBSD__) || defined(__bsdi__) || defined(__DragonFly__) || \
 //     defined(__MACH__)
 //         "-Wl,-w,-rpath,/usr/local/lib",
 // #endif
-        cxx::flags::warnAllFlag,
-        cxx::flags::outputFlag,
-        "\"" + action.cc_output.generic_string() + "\""  // output
-    );
+        cxx::flags::warnAllFlag);
 
-    if (this->dry_run) {
-        compile_cmd += std::string(cxx::flags::dryRunFlag.clang) + " ";
-    }
+    std::string dry_run_flag;
 
-    // add all the import paths:
-    if (!COMPILE_ACTIONS.empty()) {
-        for (auto &action : COMPILE_ACTIONS) {
-            compile_cmd += "\"" + action.cc_source.generic_string() + "\" ";
-        }
+    if (this->dry_run) {
+        dry_run_flag = std::string(cxx::flags::dryRunFlag.clang) + " ";
     }
 
     /// add any additional flags passed into the action
+    std::string extra_args;
+
     for (const auto &flag : action.cxx_args) {
-        compile_cmd += flag + " ";
+        extra_args += flag + " ";
     }
 
-    /// add the source file in a normalized path format
-    compile_cmd += "\"" + action.cc_source.generic_string() + "\"";
+    /// objects are cached unless nothing is compiled to one, a profile changes an object without
+    /// changing anything its key covers
+    const bool caching = !this->dry_run &&
+                         !action.flags.contains(flag::types::CompileFlags::NoCache) && pgo.empty();
 
-    /// redirect stderr to stdout
-    compile_cmd += " 2>&1";
-
-    /// execute the command
-    compile_result = exec(compile_cmd);
-
-    if (is_verbose) {
-        helix::log<LogLevel::Debug>("compile command: " + compile_cmd);
-        helix::log<LogLevel::Debug>("compiler output:\n" + compile_result.output);
-    }
+    /// diagnostics are shown as the compiler reports them, not once it exits, translated to
+    /// where they are in the helix source
+    std::map<std::string, std::vector<size_t>> line_starts;  // of the cx-ir, see `remap_err`
+    std::unordered_map<std::string, bool>      exists;       // each file is only checked once
+    std::mutex                                 reporting;    // split units report at once
+    size_t                                     reported = 0;
 
-    /// parse the output and show errors after translating them to helix errors
-    std::vector<std::string> lines;
-    std::istringstream       stream(compile_result.output);
+    auto report = [&](std::string_view line) {
+        std::string named;  // what is read from stdin is `cc_source` to the source map
 
-    DEBUG_LOG("parsing compiler output intrinsics");
-
-    for (std::string line; std::getline(stream, line);) {
-        if (line.starts_with('/')) {
-            lines.push_back(line);
+        if (piped && line.starts_with("<stdin>:")) {
+            named = action.cc_source.generic_string() + std::string(line.substr(7));
+            line  = named;
         }
-    }
 
-    DEBUG_LOG("parsing compiler output, size: " + std::to_string(lines.size()));
+        if (compiler == flag::types::Compiler::Custom || !line.starts_with('/')) {
+            return;
+        }
 
-    for (auto &line : lines) {
-        ErrorPOFNormalized err;
+        std::lock_guard<std::mutex> lock(reporting);
+        ErrorPOFNormalized          err;
 
         if (compiler == flag::types::Compiler::Clang) {
-            err = CXIRCompiler::parse_clang_err(line);
+            err = CXIRCompiler::parse_clang_err(std::string(line));
         } else if (compiler == flag::types::Compiler::GCC) {
-            err = CXIRCompiler::parse_gcc_err(line);
-        } else if (compiler == flag::types::Compiler::MSVC) {
-            err = CXIRCompiler::parse_msvc_err(line);
+            err = CXIRCompiler::parse_gcc_err(std::string(line));
         } else {
-            helix::log<LogLevel::Error>("unknown c++ compiler, raw output shown");
-            helix::log<LogLevel::Info>("output ------------>");
-            helix::log<LogLevel::Info>(compile_result.output);
-            helix::log<LogLevel::Info>("<------------ output");
-
-            if (compile_result.return_code == 0) {
-                helix::log_opt<LogLevel::Progress>(action.flags.contains(flag::types::CompileFlags::Verbose), "lowered " + action.helix_src.generic_string() +
-                                               " and compiled cxir");
-                helix::log_opt<LogLevel::Progress>(action.flags.contains(flag::types::CompileFlags::Verbose), "compiled successfully to " +
-                                               action.cc_output.generic_string());
-                return {compile_result, flag::ErrorType(flag::types::ErrorType::Success)};
+            err = CXIRCompiler::parse_msvc_err(std::string(line));
+        }
+
+        // anything the source map knows about is a helix file, so only the rest hit the disk
+        bool located = remap_err(err, action, line_starts) ||
+                       (action.source_map != nullptr &&
+                        action.source_map->has_file(std::get<2>(err))) ||
+                       std::ranges::any_of(action.parts, [&](const auto &part) {
+                           return part.source_map->has_file(std::get<2>(err));
+                       });
+
+        if (!located) {
+            auto [known, inserted] = exists.try_emplace(std::get<2>(err));
+
+            if (inserted) {
+                known->second = std::filesystem::exists(std::get<2>(err));
             }
 
-            return {compile_result, flag::ErrorType(flag::types::ErrorType::Error)};
+            located = known->second;
         }
 
-        if (!std::filesystem::exists(std::get<2>(err))) {
+        if (!located) {
             error::Panic _(error::CompilerError{
                 .err_code     = 0.8245,
                 .err_fmt_args = {"error at: " + std::get<2>(err) + std::get<1>(err)},
             });
 
-            continue;
+            return;
+        }
+
+        DEBUG_LOG("showing error: " + std::get<1>(err));
+        show_err(err);
+        ++reported;
+    };
+
+    if (action.parts.empty() && !caching) {
+        compile_cmd += make_command(compiler,
+                                    linker,
+                                    cxx::flags::outputFlag,
+                                    "\"" + action.cc_output.generic_string() + "\"");
+        compile_cmd += dry_run_flag;
+
+        // add all the import paths:
+        if (!COMPILE_ACTIONS.empty()) {
+            for (auto &action : COMPILE_ACTIONS) {
+                compile_cmd += "\"" + action.cc_source.generic_string() + "\" ";
+            }
+        }
+
+        compile_cmd += extra_args;
+
+        /// add the source file in a normalized path format, or read it from stdin
+        compile_cmd += piped ? "-" : "\"" + action.cc_source.generic_string() + "\"";
+
+        /// redirect stderr to stdout
+        compile_cmd += " 2>&1";
+
+        /// execute the command
+        compile_result = exec(compile_cmd, report, piped ? action.cc_text.get() : nullptr);
+
+        if (is_verbose) {
+            helix::log<LogLevel::Debug>("compile command: " + compile_cmd);
+            helix::log<LogLevel::Debug>("compiler output:\n" + compile_result.output);
+        }
+    } else {  // every translation unit to an object file of its own, then link them together
+        std::vector<std::string> sources = {action.cc_source.generic_string()};
+
+        for (const auto &part : action.parts) {
+            sources.push_back(part.cc_source.generic_string());
+        }
+
+        for (auto &import : COMPILE_ACTIONS) {
+            sources.push_back(import.cc_source.generic_string());
+        }
+
+        /// everything that goes into an object besides its source, nullopt when not caching
+        const std::optional<u64> installed = caching ? core_version(core) : std::nullopt;
+        Fingerprint              inputs;
+
+        inputs.add(OBJECT_CACHE_VERSION)
+            .add(action.cxx_compiler)
+            .add(toolchain->version)
+            .add(compile_cmd)
+            .add(extra_args)
+            .add(installed.value_or(0));
+
+        std::vector<std::string>                          commands;
+        std::vector<const std::string *>                  fed;      // the stdin of each command
+        std::vector<std::string>                          objects;  // written by each command
+        std::vector<std::optional<std::filesystem::path>> cached;   // and where they are kept
+        std::string                                       link_cmd = make_command(  // ...
+            compiler,
+            action.cxx_compiler,
+            ((action.flags.contains(flag::types::CompileFlags::Debug))
+                              ? cxx::flags::debugModeFlag
+                              : action.profile.optimize),
+            action.profile.codegen(compiler),
+            lto,
+            linker,
+            pgo,
+            ((action.flags.contains(flag::types::CompileFlags::Debug))
+                              ? cxx::flags::SanitizeFlag
+                              : cxx::flags::None));
+
+        for (const auto &source : sources) {
+            std::optional<std::filesystem::path> object;
+
+            /// `cc_source` comes first, it is the only one that can be piped
+            const std::string *text = piped && &source == &sources.front() ? action.cc_text.get()
+                                                                           : nullptr;
+
+            if (installed.has_value()) {
+                object = ObjectCache::find(
+                    Fingerprint(inputs)
+                        .add(text != nullptr
+                                 ? std::string_view(*text)
+                                 : std::string_view(__CONTROLLER_FS_N::read_file(source)))
+                        .value());
+            }
+
+            if (object.has_value() && ObjectCache::touch(*object)) {  // straight to the linker
+                DEBUG_LOG("object cache hit for " + source + ": " + object->generic_string());
+                link_cmd += "\"" + object->generic_string() + "\" ";
+                continue;
+            }
+
+            objects.push_back(source + ".o");
+            cached.push_back(std::move(object));
+            fed.push_back(text);
+            commands.push_back(compile_cmd +
+                               make_command(compiler,
+                                            cxx::flags::compileOnlyFlag,
+                                            cxx::flags::outputFlag,
+                                            "\"" + source + ".o\"") +
+                               dry_run_flag + extra_args +
+                               (text != nullptr ? "-" : "\"" + source + "\"") + " 2>&1");
+            link_cmd += "\"" + source + ".o\" ";
         }
 
-        std::pair<size_t, size_t> err_t = {std::get<1>(err).find_first_not_of(' '),
-                                           std::get<1>(err).find(':') -
-                                               std::get<1>(err).find_first_not_of(' ')};
+        link_cmd += extra_args +
+                    make_command(compiler,
+                                 cxx::flags::outputFlag,
+                                 "\"" + action.cc_output.generic_string() + "\"") +
+                    "2>&1";
 
-        error::Level level = std::map<string, error::Level>{
-            {"error", error::Level::ERR},                       //
-            {"warning", error::Level::WARN},                    //
-            {"note", error::Level::NOTE}                        //
-        }[std::get<1>(err).substr(err_t.first, err_t.second)];  //
+        compile_result = {};
 
-        std::string msg = std::get<1>(err).substr(err_t.first + err_t.second + 1);
+        std::vector<ExecResult> results = exec_all(commands, action.jobs, report, fed);
+        bool                    stored  = false;
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (is_verbose) {
+                helix::log<LogLevel::Debug>("compile command: " + commands[i]);
+                helix::log<LogLevel::Debug>("compiler output:\n" + results[i].output);
+            }
+
+            if (results[i].return_code == 0 && cached[i].has_value()) {
+                ObjectCache::store(objects[i], *cached[i]);
+                stored = true;
+            }
+
+            compile_result.output += results[i].output;
+            compile_result.return_code = compile_result.return_code != 0
+                                             ? compile_result.return_code
+                                             : results[i].return_code;
+        }
 
-        msg = msg.substr(msg.find_first_not_of(' '));
+        if (compile_result.return_code == 0 && !this->dry_run) {
+            ExecResult linked = exec(link_cmd, report);
 
-        DEBUG_LOG("showing error: " + msg);
-        error::Panic(error::CodeError{
-            .pof          = &std::get<0>(err),
-            .err_code     = 0.8245,
-            .mark_pof     = true,
-            .err_fmt_args = {msg},
-            .level        = level,
-            .indent       = static_cast<size_t>((level == error::NOTE) ? 1 : 0),
-        });
-        DEBUG_LOG("error shown");
+            if (is_verbose) {
+                helix::log<LogLevel::Debug>("link command: " + link_cmd);
+                helix::log<LogLevel::Debug>("linker output:\n" + linked.output);
+            }
+
+            compile_result.output += linked.output;
+            compile_result.return_code = linked.return_code;
+        }
+
+        if (stored) {
+            ObjectCache::trim();
+        }
+    }
+
+    if (compiler == flag::types::Compiler::Custom && !compile_result.output.empty()) {
+        helix::log<LogLevel::Error>("unknown c++ compiler, raw output shown");
+        helix::log<LogLevel::Info>("output ------------>");
+        helix::log<LogLevel::Info>(compile_result.output);
+        helix::log<LogLevel::Info>("<------------ output");
     }
 
+    DEBUG_LOG("compiler diagnostics shown: " + std::to_string(reported));
+
     if (compile_result.return_code == 0) {
         helix::log_opt<LogLevel::Progress>(action.flags.contains(flag::types::CompileFlags::Verbose), "lowered " + action.helix_src.generic_string() +
                                        " and compiled cxir");
@@ -250,6 +451,66 @@ CXIRCompiler::CompileResult CXIRCompiler::CXIR_CXX(const CXXCompileAction &actio
 
     DEBUG_LOG("returning error");
     return {compile_result,
-            flag::ErrorType(error::HAS_ERRORED ? flag::types::ErrorType::Error
-                                               : flag::types::ErrorType::Success)};
+            flag::ErrorType(error::HAS_ERRORED || compiler == flag::types::Compiler::Custom
+                                ? flag::types::ErrorType::Error
+                                : flag::types::ErrorType::Success)};
+}
+
+std::vector<CXIRCompiler::ExecResult>
+CXIRCompiler::exec_all(const std::vector<std::string>         &cmds,
+                       size_t                                  jobs,
+                       const LineCallback                     &on_line,
+                       const std::vector<const std::string *> &inputs) {
+    std::vector<ExecResult>         results(cmds.size());
+    std::vector<std::exception_ptr> errors(cmds.size());
+    std::atomic<size_t>             next = 0;
+
+    jobs = std::min(jobs != 0 ? jobs : std::max(std::thread::hardware_concurrency(), 1U),
+                    cmds.size());
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(jobs);
+
+        for (size_t worker = 0; worker < jobs; ++worker) {
+            workers.emplace_back([&] {
+                for (size_t i = next++; i < cmds.size(); i = next++) {
+                    try {
+                        results[i] = exec(cmds[i], on_line, inputs.empty() ? nullptr : inputs[i]);
+                    } catch (...) { errors[i] = std::current_exception(); }
+                }
+            });
+        }
+    }  // joined here
+
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return results;
+}
+
+void CXIRCompiler::split_lines(std::string        &pending,
+                               std::string_view    data,
+                               const LineCallback &on_line) {
+    if (!on_line) {
+        return;
+    }
+
+    for (size_t newline = data.find('\n'); newline != std::string_view::npos;
+         newline        = data.find('\n')) {
+        if (pending.empty()) {  // the common case, the line is whole in `data`
+            on_line(data.substr(0, newline));
+        } else {
+            pending.append(data.substr(0, newline));
+            on_line(pending);
+            pending.clear();
+        }
+
+        data.remove_prefix(newline + 1);
+    }
+
+    pending.append(data);
 }
@@ -0,0 +1,323 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/CodeGen/CodeGenAction.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/Utils.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/config/cxx_flags.hh"
+#include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/logger.hh"
+#include "controller/include/tooling/tooling.hh"
+
+#ifndef DEBUG_LOG
+#define DEBUG_LOG(...)                            \
+    if (is_verbose) {                             \
+        helix::log<LogLevel::Debug>(__VA_ARGS__); \
+    }
+#endif
+
+namespace {
+/// every diagnostic clang reports, resolved while its source manager is still alive
+class DiagnosticCollector : public clang::DiagnosticConsumer {
+  public:
+    struct Reported {
+        clang::DiagnosticsEngine::Level level;
+        std::string                     message;
+        std::string                     file;  // empty when the diagnostic has no location
+        unsigned                        line   = 0;
+        unsigned                        column = 0;
+        std::optional<unsigned>         offset;  // into the cx-ir, when it points there
+    };
+
+    std::vector<Reported> reported;
+
+    void HandleDiagnostic(clang::DiagnosticsEngine::Level level,
+                          const clang::Diagnostic        &info) override {
+        DiagnosticConsumer::HandleDiagnostic(level, info);  // keeps the error count
+
+        llvm::SmallString<256> message;
+        info.FormatDiagnostic(message);
+
+        Reported diag{.level = level, .message = message.str().str()};
+
+        if (info.hasSourceManager() && info.getLocation().isValid()) {
+            const clang::SourceManager &sources  = info.getSourceManager();
+            const clang::SourceLocation loc      = sources.getFileLoc(info.getLocation());
+            const clang::PresumedLoc    presumed = sources.getPresumedLoc(loc);
+            const auto [file_id, offset] = sources.getDecomposedLoc(loc);
+
+            if (file_id == sources.getMainFileID()) {
+                diag.offset = offset;
+            }
+
+            if (presumed.isValid()) {
+                diag.file   = presumed.getFilename();
+                diag.line   = presumed.getLine();
+                diag.column = presumed.getColumn();
+            }
+        }
+
+        reported.push_back(std::move(diag));
+    }
+};
+
+/// splits a `CF` spelling such as `-g -g3` into separate arguments
+void add_flags(std::vector<std::string> &args, std::string_view flags) {
+    for (size_t start = 0; start < flags.size();) {
+        size_t end = std::min(flags.find(' ', start), flags.size());
+
+        if (end != start) {
+            args.emplace_back(flags.substr(start, end - start));
+        }
+
+        start = end + 1;
+    }
+}
+}  // namespace
+
+CXIRCompiler::CompileResult CXIRCompiler::CXIR_CLANG(const CXXCompileAction &action) const {
+    bool is_verbose = action.flags.contains(EFlags(flag::types::CompileFlags::Verbose));
+    bool is_debug   = action.flags.contains(EFlags(flag::types::CompileFlags::Debug));
+
+    const std::filesystem::path exe       = __CONTROLLER_FS_N::get_exe();
+    const std::string           resources = clang::driver::Driver::GetResourcesPath(exe.string());
+
+    // the builtin headers (stddef.h, ...) are not part of helix itself, without them the system
+    // compiler has to do the work
+    if (action.cc_text == nullptr || !std::filesystem::exists(resources + "/include")) {
+        DEBUG_LOG("clang resource directory not found at " + resources);
+        return {{}, flag::ErrorType(flag::types::ErrorType::NotFound)};
+    }
+
+    if (!action.profile.target.empty()) {  // only the native target is linked in
+        DEBUG_LOG("cross compiling to " + action.profile.target + " with the system compiler");
+        return {{}, flag::ErrorType(flag::types::ErrorType::NotFound)};
+    }
+
+    // the profile runtime comes with the system compiler, and so does llvm-profdata
+    if (!action.profile.profile_generate.empty() || !action.profile.profile_use.empty()) {
+        DEBUG_LOG("profile guided build, compiling with the system compiler");
+        return {{}, flag::ErrorType(flag::types::ErrorType::NotFound)};
+    }
+
+    auto core = exe.parent_path().parent_path() / "core" / "include" / "core.h";
+
+    if (!std::filesystem::exists(core)) {
+        helix::log<LogLevel::Error>("core lib not found, verify the installation");
+        return {{}, flag::ErrorType(flag::types::ErrorType::NotFound)};
+    }
+
+    static const bool targets_ready = [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+        return true;
+    }();
+    (void)targets_ready;
+
+    const std::string source = action.cc_source.generic_string();
+    const std::string object = source + ".o";
+
+    /// the same language as `CXIR_CXX`, sanitizers are left out since the objects are linked by
+    /// the system compiler whose sanitizer runtime may not be clang's, and so is lto
+    std::vector<std::string> args = {exe.string()};
+
+    add_flags(args,
+              is_debug ? cxx::flags::debugModeFlag.clang : action.profile.optimize.clang);
+    add_flags(args, action.profile.codegen(flag::types::Compiler::Clang));
+    add_flags(args, cxx::flags::cxxStandardFlag.clang);
+    add_flags(args, cxx::flags::stdCXX23Flag.clang);
+    add_flags(args, cxx::flags::enableExceptionsFlag.clang);
+    add_flags(args, cxx::flags::noOmitFramePointerFlag.clang);
+    add_flags(args, cxx::flags::warnAllFlag.clang);
+
+    args.insert(args.end(), {"-include", core.generic_string()});
+
+    for (const auto &flag : action.cxx_args) {  // the rest of them are for the linker
+        if (flag.starts_with("-D") || flag.starts_with("-U") || flag.starts_with("-I") ||
+            flag.starts_with("-f") || flag.starts_with("-m")) {
+            args.push_back(flag);
+        }
+    }
+
+    args.insert(args.end(),
+                {this->dry_run ? std::string(cxx::flags::dryRunFlag.clang)
+                               : std::string(cxx::flags::compileOnlyFlag.clang),
+                 source,
+                 "-o",
+                 object});
+
+    std::vector<const char *> argv;
+    argv.reserve(args.size());
+
+    for (const auto &arg : args) {
+        argv.push_back(arg.c_str());
+    }
+
+    /// the cx-ir never touches the disk, clang reads it out of memory under its usual name
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memory(
+        new llvm::vfs::InMemoryFileSystem);
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> files(
+        new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem()));
+
+    memory->addFile(source, 0, llvm::MemoryBuffer::getMemBuffer(*action.cc_text, source, false));
+    files->pushOverlay(memory);
+
+    DiagnosticCollector collector;
+
+    clang::CreateInvocationOptions options;
+    options.Diags = clang::CompilerInstance::createDiagnostics(
+        new clang::DiagnosticOptions, &collector, /* ShouldOwnClient */ false);
+    options.VFS = files;
+
+    std::shared_ptr<clang::CompilerInvocation> invocation =
+        clang::createInvocation(argv, std::move(options));
+
+    DEBUG_LOG("in process compile: " +
+              std::accumulate(args.begin(),
+                              args.end(),
+                              std::string(),
+                              [](const std::string &a, const std::string &b) {
+                                  return a.empty() ? b : a + " " + b;
+                              }));
+
+    bool compiled = false;
+
+    if (invocation != nullptr) {
+        clang::CompilerInstance compiler;
+
+        compiler.setInvocation(std::move(invocation));
+        compiler.createDiagnostics(&collector, /* ShouldOwnClient */ false);
+        compiler.createFileManager(files);
+
+        if (this->dry_run) {
+            clang::SyntaxOnlyAction syntax_only;
+            compiled = compiler.ExecuteAction(syntax_only);
+        } else {
+            clang::EmitObjAction emit_object;
+            compiled = compiler.ExecuteAction(emit_object);
+        }
+    }
+
+    for (auto &diag : collector.reported) {
+        std::string level;
+
+        switch (diag.level) {
+            case clang::DiagnosticsEngine::Note:
+                level = "note";
+                break;
+            case clang::DiagnosticsEngine::Warning:
+                level = "warning";
+                break;
+            case clang::DiagnosticsEngine::Error:
+            case clang::DiagnosticsEngine::Fatal:
+                level = "error";
+                break;
+            default:  // remarks and ignored diagnostics
+                continue;
+        }
+
+        std::optional<generator::CXIR::SourceLocation> loc;
+
+        if (diag.offset.has_value() && action.source_map != nullptr) {
+            loc = action.source_map->find(*diag.offset);
+        }
+
+        ErrorPOFNormalized err;
+
+        if (loc.has_value()) {
+            const std::string &file_path = action.source_map->file(loc->file);
+
+            err = {token::Token(loc->line,
+                                loc->column,
+                                loc->length,
+                                loc->column + loc->line,
+                                "/*error*/",
+                                file_path,
+                                "<other>"),
+                   level + ": " + diag.message,
+                   file_path,
+                   loc->column};
+        } else if (!diag.file.empty()) {
+            err = {token::Token(diag.line,
+                                diag.column,
+                                1,
+                                diag.column + diag.line,
+                                "/*error*/",
+                                diag.file,
+                                "<other>"),
+                   level + ": " + diag.message,
+                   diag.file,
+                   diag.column};
+        } else {
+            helix::log<LogLevel::Error>(level + ": " + diag.message);
+            continue;
+        }
+
+        DEBUG_LOG("showing error: " + diag.message);
+        show_err(err);
+    }
+
+    if (!compiled || collector.getNumErrors() != 0) {
+        return {{}, flag::ErrorType(flag::types::ErrorType::Error)};
+    }
+
+    ExecResult linked;
+
+    if (!this->dry_run) {  // the driver would spawn the linker as well
+        std::string link_cmd = action.cxx_compiler + " ";
+
+        for (const auto &flag : action.cxx_args) {
+            link_cmd += flag + " ";
+        }
+
+        link_cmd += "\"" + object + "\" -o \"" + action.cc_output.generic_string() + "\" 2>&1";
+        linked = exec(link_cmd);
+
+        DEBUG_LOG("link command: " + link_cmd);
+        DEBUG_LOG("linker output:\n" + linked.output);
+
+        if (linked.return_code != 0) {
+            helix::log<LogLevel::Error>("linking failed:\n" + linked.output);
+            return {linked, flag::ErrorType(flag::types::ErrorType::Error)};
+        }
+    }
+
+    helix::log_opt<LogLevel::Progress>(
+        is_verbose, "lowered " + action.helix_src.generic_string() + " and compiled cxir");
+    helix::log_opt<LogLevel::Progress>(
+        is_verbose, "compiled successfully to " + action.cc_output.generic_string());
+
+    return {linked, flag::ErrorType(flag::types::ErrorType::Success)};
+}
@@ -13,7 +13,9 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <fstream>
 #include <map>
+#include <regex>
 
 #include "controller/include/shared/file_system.hh"
 #include "controller/include/tooling/tooling.hh"
@@ -60,11 +62,8 @@ std::tuple<size_t, size_t> get_meta(const std::string &file_name, size_t line_nu
     }  // we now have the col num
 
     // strip all whitespace on the right
-    (*data).erase(std::find_if((*data).rbegin(),
-                               (*data).rend(),
-                               [](unsigned char chr) { return std::isspace(chr) == 0; })
-                      .base(),
-                  (*data).end());
+    const size_t last = data->find_last_not_of(" \t\n\v\f\r");
+    *data             = data->substr(0, last == std::string_view::npos ? 0 : last + 1);
 
     // now get the (*data) length and - col_num
     return {col_num - 1, (*data).length() - col_num + 1};
@@ -84,11 +83,8 @@ CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_clang_err(std::string clang
     stream.ignore();                       // Ignore the next colon
     std::getline(stream, message);         // Extract the message
 
-    // see if filepath is in std::unordered_map<std::string, SourceMap> SOURCE_MAPS
-    // if it is, call SOURCE_MAPS[file_path].get_pof(line_number, column_number, length)
-
     if (file_path.empty()) {
-        return {token::Token(), "", ""};
+        return {token::Token(), "", "", 0};
     }
 
     // open the cached file jump to the line and get the length and col
@@ -102,7 +98,7 @@ CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_clang_err(std::string clang
                                     file_path,
                                     "<other>");
 
-    return {pof, message, file_path};
+    return {pof, message, file_path, column_number};
 }
 
 CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_gcc_err(std::string gcc_out) {
@@ -126,7 +122,7 @@ CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_msvc_err(std::string msvc_o
 
     // Extract the file path up to the opening parenthesis '('
     if (!std::getline(stream, file_path, '(')) {
-        return {token::Token(), "", ""};
+        return {token::Token(), "", "", 0};
     }
 
     // Verify if the extracted portion is a valid file path
@@ -137,27 +133,27 @@ CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_msvc_err(std::string msvc_o
     } catch (...) { isFile = false; }
 
     if (!isFile) {
-        return {token::Token(), "", ""};
+        return {token::Token(), "", "", 0};
     }
 
     // Parse the line number between the parentheses
     char opening_parenthesis = msvc_out[file_path.size()];  // First character after file_path
     if (opening_parenthesis != '(') {
-        return {token::Token(), "", ""};  // Invalid format
+        return {token::Token(), "", "", 0};  // Invalid format
     }
 
     char closing_parenthesis;
     stream >> line_number >> closing_parenthesis;
 
     if (closing_parenthesis != ')') {
-        return {token::Token(), "", ""};  // Invalid format
+        return {token::Token(), "", "", 0};  // Invalid format
     }
 
     // Ensure the colon after the closing parenthesis
     char colon;
     stream >> colon;
     if (colon != ':') {
-        return {token::Token(), "", ""};
+        return {token::Token(), "", "", 0};
     }
 
     // Extract the error message
@@ -176,6 +172,100 @@ CXIRCompiler::ErrorPOFNormalized CXIRCompiler::parse_msvc_err(std::string msvc_o
                        file_path,
                        "<other>");
 
-    return {pof, message, file_path};
+    return {pof, message, file_path, 0};
+}
+
+bool CXIRCompiler::remap_err(ErrorPOFNormalized                          &err,
+                             const CXXCompileAction                      &action,
+                             std::map<std::string, std::vector<size_t>> &line_starts) {
+    const generator::CXIR::SourceMap *map = nullptr;
+
+    if (std::get<2>(err) == action.cc_source.generic_string()) {
+        map = action.source_map.get();
+    } else {
+        for (const auto &part : action.parts) {
+            if (std::get<2>(err) == part.cc_source.generic_string()) {
+                map = part.source_map.get();
+                break;
+            }
+        }
+    }
+
+    if (map == nullptr || map->empty()) {
+        return false;
+    }
+
+    auto [starts, inserted] = line_starts.try_emplace(std::get<2>(err));
+
+    if (inserted && map == action.source_map.get() && action.cc_text != nullptr) {  // not on disk
+        const std::string &text = *action.cc_text;
+
+        starts->second.push_back(0);
+
+        for (size_t newline = text.find('\n'); newline != std::string::npos;
+             newline        = text.find('\n', newline + 1)) {
+            starts->second.push_back(newline + 1);
+        }
+    } else if (inserted) {  // only read once per compile, and only if something points here
+        std::ifstream file(std::get<2>(err), std::ios::binary);
+        size_t        offset = 0;
+
+        starts->second.push_back(0);
+
+        for (std::string line; std::getline(file, line);) {
+            offset += line.size() + 1;
+            starts->second.push_back(offset);
+        }
+    }
+
+    const size_t line   = std::get<0>(err).line_number();
+    const size_t column = std::max<size_t>(std::get<3>(err), 1);
+
+    if (line == 0 || line >= starts->second.size()) {
+        return false;
+    }
+
+    auto loc = map->find(starts->second[line - 1] + column - 1);
+
+    if (!loc.has_value()) {
+        return false;
+    }
+
+    const std::string &file_path = map->file(loc->file);
+
+    std::get<0>(err) = token::Token(loc->line,
+                                    loc->column,
+                                    loc->length,
+                                    loc->column + loc->line,
+                                    "/*error*/",
+                                    file_path,
+                                    "<other>");
+    std::get<2>(err) = file_path;
+
+    return true;
 }
 
+void CXIRCompiler::show_err(ErrorPOFNormalized &err) {
+    std::pair<size_t, size_t> err_t = {std::get<1>(err).find_first_not_of(' '),
+                                       std::get<1>(err).find(':') -
+                                           std::get<1>(err).find_first_not_of(' ')};
+
+    error::Level level = std::map<string, error::Level>{
+        {"error", error::Level::ERR},                       //
+        {"warning", error::Level::WARN},                    //
+        {"note", error::Level::NOTE}                        //
+    }[std::get<1>(err).substr(err_t.first, err_t.second)];  //
+
+    std::string msg = std::get<1>(err).substr(err_t.first + err_t.second + 1);
+
+    msg = msg.substr(msg.find_first_not_of(' '));
+
+    error::Panic(error::CodeError{
+        .pof          = &std::get<0>(err),
+        .err_code     = 0.8245,
+        .mark_pof     = true,
+        .err_fmt_args = {msg},
+        .level        = level,
+        .indent       = static_cast<size_t>((level == error::NOTE) ? 1 : 0),
+    });
+}
@@ -19,40 +19,365 @@
     defined(__NetBSD__) || defined(__OpenBSD__) || defined(__bsdi__) || defined(__DragonFly__) || \
     defined(__MACH__)
 
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
-#include <cstdio>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
-CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
-    std::array<char, 128> buffer;
-    std::string           result;
+extern char **environ;  // NOLINT, posix only declares it for the program to define
 
-    FILE *pipe = popen(cmd.c_str(), "r");
-    if (!pipe) {
-        throw std::runtime_error("popen() failed to initialize command execution.");
+namespace {
+struct Command {
+    std::vector<std::string> argv;
+    bool                     merge_stderr = false;  // `2>&1`, stderr is part of the output
+};
+
+/// splits `cmd` into arguments the way sh would, for the quoting the driver itself produces
+/// \returns nullopt if anything in it needs an actual shell (expansions, pipes, redirections)
+std::optional<Command> parse_command(std::string_view cmd) {
+    Command     parsed;
+    std::string arg;
+    bool        in_arg = false;
+    char        quote  = 0;
+
+    auto finish = [&] {
+        if (!in_arg) {
+            return;
+        }
+
+        if (arg == "2>&1") {
+            parsed.merge_stderr = true;
+        } else {
+            parsed.argv.push_back(std::move(arg));
+        }
+
+        arg.clear();
+        in_arg = false;
+    };
+
+    for (size_t i = 0; i < cmd.size(); ++i) {
+        const char c = cmd[i];
+
+        if (quote == '\'') {  // nothing is special inside single quotes
+            if (c == '\'') {
+                quote = 0;
+            } else {
+                arg += c;
+            }
+
+            continue;
+        }
+
+        if (quote == '"') {
+            if (c == '"') {
+                quote = 0;
+            } else if (c == '$' || c == '`') {
+                return std::nullopt;
+            } else if (c == '\\' && i + 1 < cmd.size() && std::strchr("\"\\", cmd[i + 1])) {
+                arg += cmd[++i];
+            } else {
+                arg += c;
+            }
+
+            continue;
+        }
+
+        switch (c) {
+            case ' ':
+            case '\t':
+            case '\n':
+                finish();
+                break;
+            case '\'':
+            case '"':
+                quote  = c;
+                in_arg = true;
+                break;
+            case '\\':
+                if (i + 1 < cmd.size()) {
+                    arg += cmd[++i];
+                    in_arg = true;
+                }
+                break;
+            case '>':  // only a whole `2>&1` is understood
+                if (arg == "2" && cmd.substr(i, 3) == ">&1" &&
+                    (i + 3 == cmd.size() || cmd[i + 3] == ' ')) {
+                    arg = "2>&1";
+                    i += 2;
+                    break;
+                }
+                return std::nullopt;
+            case '|':
+            case '&':
+            case ';':
+            case '<':
+            case '$':
+            case '`':
+            case '*':
+            case '?':
+            case '(':
+            case ')':
+            case '~':
+                return std::nullopt;
+            default:
+                arg += c;
+                in_arg = true;
+                break;
+        }
+    }
+
+    if (quote != 0) {
+        return std::nullopt;
+    }
+
+    finish();
+    return parsed;
+}
+
+void close_fd(int &fd) {
+    if (fd != -1) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || \
+    defined(__DragonFly__)
+/// pipe2 sets close-on-exec atomically, other threads are free to spawn meanwhile
+std::unique_lock<std::mutex> spawn_lock() { return {}; }
+
+int open_pipe(std::array<int, 2> &fds) { return pipe2(fds.data(), O_CLOEXEC); }
+#else
+/// a pipe is inheritable until its fcntl, a spawn from another thread in between would take it
+/// along, so pipes are created and children spawned by one thread at a time
+std::unique_lock<std::mutex> spawn_lock() {
+    static std::mutex spawning;
+    return std::unique_lock<std::mutex>(spawning);
+}
+
+int open_pipe(std::array<int, 2> &fds) {
+    if (pipe(fds.data()) == -1) {
+        return -1;
     }
 
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+}
+#endif
+
+/// a pipe neither end of which leaks into processes spawned by other threads, as long as it
+/// is made under `spawn_lock`
+/// \param ours the end this process uses, it does not block. the child's end has to
+std::array<int, 2> make_pipe(size_t ours) {
+    std::array<int, 2> fds{-1, -1};
+
+    if (open_pipe(fds) == -1) {
+        throw std::runtime_error(std::string("pipe() failed: ") + std::strerror(errno));
+    }
+
+    fcntl(fds[ours], F_SETFL, fcntl(fds[ours], F_GETFL) | O_NONBLOCK);
+    return fds;
+}
+}  // namespace
+
+CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string  &cmd,
+                                            const LineCallback &on_line,
+                                            const std::string  *input) {
+    std::optional<Command> parsed = parse_command(cmd);
+    Command                command;
+
+    if (parsed.has_value() && !parsed->argv.empty()) {  // no shell in between
+        command = std::move(*parsed);
+    } else {
+        command.argv = {"/bin/sh", "-c", cmd};
+    }
+
+    std::array<int, 2> out{-1, -1};
+    std::array<int, 2> err{-1, -1};
+    std::array<int, 2> in{-1, -1};  // only a pipe when there is something to feed
+
+    std::unique_lock<std::mutex> spawning = spawn_lock();
+
     try {
-        while (feof(pipe) == 0) {
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
-                result += buffer.data();
-            }
+        out = make_pipe(0);
+        err = make_pipe(0);
+
+        if (input != nullptr) {
+            in = make_pipe(1);
         }
     } catch (...) {
-        pclose(pipe);
+        for (auto *fds : {&out, &err, &in}) {
+            close_fd((*fds)[0]);
+            close_fd((*fds)[1]);
+        }
+
         throw;
     }
 
-    // Close the pipe and check the return code
-    int rc = pclose(pipe);
-    if (rc == 0) {
-        return {result, 0};
+    if (input != nullptr) {  // a compiler that exits early fails the write, it does not kill us
+        static const bool ignored = signal(SIGPIPE, SIG_IGN) != SIG_ERR;
+        (void)ignored;
+    }
+
+    std::vector<char *> argv;
+    argv.reserve(command.argv.size() + 1);
+
+    for (auto &arg : command.argv) {
+        argv.push_back(arg.data());
+    }
+
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+
+    if (input != nullptr) {
+        posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+    } else {
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    }
+
+    posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, err[1], STDERR_FILENO);
+
+    /// an ignored SIGPIPE would be inherited, the child gets the default back
+    posix_spawnattr_t attributes;
+    sigset_t          restored;
+
+    posix_spawnattr_init(&attributes);
+    sigemptyset(&restored);
+    sigaddset(&restored, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attributes, &restored);
+
+#if defined(__APPLE__)  // and only the descriptors dup2'd above survive into the child
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_CLOEXEC_DEFAULT);
+#else
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+#endif
+
+    pid_t     pid     = -1;
+    const int spawned = posix_spawnp(&pid, argv[0], &actions, &attributes, argv.data(), environ);
+
+    if (spawning.owns_lock()) {
+        spawning.unlock();
+    }
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&actions);
+    close_fd(out[1]);
+    close_fd(err[1]);
+    close_fd(in[0]);
+
+    if (spawned != 0) {
+        close_fd(out[0]);
+        close_fd(err[0]);
+        close_fd(in[1]);
+
+        // what the shell would have said
+        return {command.argv[0] + ": " + std::strerror(spawned) + "\n",
+                spawned == ENOENT ? 127 : 126};
+    }
+
+    std::string            result;
+    std::string            pending[2];  // the unfinished last line of stdout and stderr
+    std::array<char, 4096> buffer{};
+
+    /// whole lines go to `on_line` as they arrive, stderr only when it is part of the output
+    auto take = [&](size_t stream, std::string_view data) {
+        if (stream == 1 && !command.merge_stderr) {
+            (void)!write(STDERR_FILENO, data.data(), data.size());
+            return;
+        }
+
+        split_lines(pending[stream], data, on_line);
+        result += data;
+    };
+
+    /// stdout, stderr and stdin, fed alongside reading so neither side waits on a full pipe
+    std::array<pollfd, 3> fds = {
+        pollfd{out[0], POLLIN, 0}, pollfd{err[0], POLLIN, 0}, pollfd{in[1], POLLOUT, 0}};
+    std::string_view feed = input != nullptr ? std::string_view(*input) : std::string_view();
+
+    if (fds[2].fd != -1 && feed.empty()) {
+        close_fd(fds[2].fd);
+    }
+
+    while (std::ranges::any_of(fds, [](const pollfd &fd) { return fd.fd != -1; })) {
+        if (poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        if (fds[2].fd != -1 && fds[2].revents != 0) {
+            const ssize_t put =
+                write(fds[2].fd, feed.data(), std::min<size_t>(feed.size(), buffer.size() * 16));
+
+            if (put > 0) {
+                feed.remove_prefix(static_cast<size_t>(put));
+            }
+
+            // all of it is the end of its input, an error means it stopped reading
+            if (feed.empty() || (put == -1 && errno != EAGAIN && errno != EINTR)) {
+                close_fd(fds[2].fd);
+            }
+        }
+
+        for (size_t stream = 0; stream < 2; ++stream) {
+            if (fds[stream].fd == -1 || fds[stream].revents == 0) {
+                continue;
+            }
+
+            const ssize_t got = read(fds[stream].fd, buffer.data(), buffer.size());
+
+            if (got > 0) {
+                take(stream, std::string_view(buffer.data(), static_cast<size_t>(got)));
+            } else if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+                close(fds[stream].fd);
+                fds[stream].fd = -1;  // poll skips negative descriptors
+            }
+        }
+    }
+
+    for (auto &fd : fds) {
+        close_fd(fd.fd);
+    }
+
+    for (auto &rest : pending) {  // output that did not end in a newline
+        if (!rest.empty() && on_line) {
+            on_line(rest);
+        }
+    }
+
+    int status = 0;
+
+    while (waitpid(pid, &status, 0) == -1) {
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("waitpid() failed: ") + std::strerror(errno));
+        }
+    }
+
+    if (WIFEXITED(status)) {
+        return {result, WEXITSTATUS(status)};
     }
 
-    return {result, rc};
+    return {result, 128 + (WIFSIGNALED(status) ? WTERMSIG(status) : 0)};
 }
 
 #endif
@@ -19,14 +19,21 @@
 
 #include <windows.h>
 
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 
-CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
+CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string  &cmd,
+                                            const LineCallback &on_line,
+                                            const std::string  *input) {
     SECURITY_ATTRIBUTES sa         = {sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
     HANDLE              hReadPipe  = nullptr;
     HANDLE              hWritePipe = nullptr;
+    HANDLE              hInRead    = nullptr;  // stdin, only when there is something to feed
+    HANDLE              hInWrite   = nullptr;
 
     if (CreatePipe(&hReadPipe, &hWritePipe, &sa, 0) == 0) {
         throw std::runtime_error("CreatePipe failed! Error: " + std::to_string(GetLastError()));
@@ -39,11 +46,25 @@ CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
                                  std::to_string(GetLastError()));
     }
 
+    if (input != nullptr && (CreatePipe(&hInRead, &hInWrite, &sa, 0) == 0 ||
+                             SetHandleInformation(hInWrite, HANDLE_FLAG_INHERIT, 0) == 0)) {
+        const DWORD error = GetLastError();
+
+        for (HANDLE handle : {hReadPipe, hWritePipe, hInRead, hInWrite}) {
+            if (handle != nullptr) {
+                CloseHandle(handle);
+            }
+        }
+
+        throw std::runtime_error("CreatePipe failed! Error: " + std::to_string(error));
+    }
+
     PROCESS_INFORMATION pi = {};
     STARTUPINFO         si = {};
     si.cb                  = sizeof(si);
     si.hStdOutput          = hWritePipe;
     si.hStdError           = hWritePipe;
+    si.hStdInput           = hInRead;
     si.dwFlags |= STARTF_USESTDHANDLES;
 
     if (!CreateProcess(nullptr,
@@ -56,14 +77,46 @@ CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
                        nullptr,
                        &si,
                        &pi)) {
-        CloseHandle(hReadPipe);
-        CloseHandle(hWritePipe);
-        throw std::runtime_error("CreateProcess failed! Error: " + std::to_string(GetLastError()));
+        const DWORD error = GetLastError();
+
+        for (HANDLE handle : {hReadPipe, hWritePipe, hInRead, hInWrite}) {
+            if (handle != nullptr) {
+                CloseHandle(handle);
+            }
+        }
+
+        throw std::runtime_error("CreateProcess failed! Error: " + std::to_string(error));
     }
 
     CloseHandle(hWritePipe);
 
+    if (hInRead != nullptr) {
+        CloseHandle(hInRead);
+    }
+
+    /// fed from a thread of its own so neither side waits on a full pipe
+    std::thread writerThread([&]() {
+        if (hInWrite == nullptr) {
+            return;
+        }
+
+        std::string_view feed    = *input;
+        DWORD            written = 0;
+
+        while (!feed.empty() &&
+               WriteFile(hInWrite,
+                         feed.data(),
+                         static_cast<DWORD>(std::min<size_t>(feed.size(), 1 << 16)),
+                         &written,
+                         nullptr) != 0) {
+            feed.remove_prefix(written);
+        }
+
+        CloseHandle(hInWrite);  // the end of its input, or it stopped reading
+    });
+
     std::string           result;
+    std::string           pending;  // the unfinished last line
     std::array<char, 128> buffer{};
 
     DWORD bytesRead = 0;
@@ -78,6 +131,7 @@ CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
                                          std::to_string(GetLastError()));
             }
             result.append(buffer.data(), bytesRead);
+            split_lines(pending, std::string_view(buffer.data(), bytesRead), on_line);
         }
     });
 
@@ -85,6 +139,7 @@ CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
     if (waitResult == WAIT_TIMEOUT) {
         TerminateProcess(pi.hProcess, 1);
         readerThread.join();
+        writerThread.join();
         CloseHandle(hReadPipe);
         CloseHandle(pi.hProcess);
         CloseHandle(pi.hThread);
@@ -92,6 +147,11 @@ CXIRCompiler::ExecResult CXIRCompiler::exec(const std::string &cmd) {
     }
 
     readerThread.join();
+    writerThread.join();
+
+    if (!pending.empty() && on_line) {
+        on_line(pending);
+    }
 
     DWORD exitCode = 0;
     if (GetExitCodeProcess(pi.hProcess, &exitCode) == 0) {
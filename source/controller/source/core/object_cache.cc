@@ -0,0 +1,103 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "controller/include/shared/fingerprint.hh"
+#include "controller/include/tooling/tooling.hh"
+
+std::optional<std::filesystem::path> ObjectCache::find(u64 key) {
+    // private to the user, nobody else can plant an object that gets linked into their build
+    const std::optional<std::filesystem::path> dir = BuildCache::dir("objects");
+
+    if (!dir.has_value()) {
+        return std::nullopt;
+    }
+
+    return *dir / (Fingerprint().add(key).hex() + ".o");
+}
+
+bool ObjectCache::touch(const std::filesystem::path &cached) {
+    std::error_code ec;
+
+    // the modification time doubles as the last use, so `trim` drops the stalest first
+    std::filesystem::last_write_time(cached, std::filesystem::file_time_type::clock::now(), ec);
+
+    return !ec;
+}
+
+void ObjectCache::store(const std::filesystem::path &object, const std::filesystem::path &cached) {
+    std::error_code             ec;
+    const std::filesystem::path tmp = BuildCache::scratch(cached);
+
+    std::filesystem::copy_file(object, tmp, std::filesystem::copy_options::overwrite_existing, ec);
+
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    BuildCache::publish(tmp, cached);
+}
+
+void ObjectCache::trim() {
+    struct Entry {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type used;
+        uintmax_t                       size;
+    };
+
+    const std::optional<std::filesystem::path> dir = BuildCache::dir("objects");
+    std::error_code                            ec;
+    std::vector<Entry>                         entries;
+    uintmax_t                                  total = 0;
+
+    if (!dir.has_value()) {
+        return;
+    }
+
+    for (const auto &entry : std::filesystem::directory_iterator(*dir, ec)) {
+        if (!entry.is_regular_file(ec) || entry.path().extension() != ".o") {
+            continue;
+        }
+
+        Entry cached{entry.path(), entry.last_write_time(ec), entry.file_size(ec)};
+
+        if (!ec) {
+            total += cached.size;
+            entries.push_back(std::move(cached));
+        }
+    }
+
+    if (total <= LIMIT) {
+        return;
+    }
+
+    // down to three quarters, so the next few builds do not each pay for a scan and a trim
+    std::ranges::sort(entries, {}, &Entry::used);
+
+    for (const auto &entry : entries) {
+        if (total <= LIMIT / 4 * 3) {
+            break;
+        }
+
+        if (std::filesystem::remove(entry.path, ec)) {
+            total -= entry.size;
+        }
+    }
+}
@@ -0,0 +1,149 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "controller/include/config/cxx_flags.hh"
+#include "controller/include/shared/fingerprint.hh"
+#include "controller/include/shared/logger.hh"
+#include "controller/include/tooling/tooling.hh"
+
+namespace {
+constexpr u64 PCH_VERSION = 1;  // bump when the layout of the cache changes
+}  // namespace
+
+std::string CXIRCompiler::core_include(const CXXCompileAction      &action,
+                                       const Toolchain             &toolchain,
+                                       const std::filesystem::path &core,
+                                       const std::string           &language_flags) {
+    const std::string plain = "-include \"" + core.generic_string() + "\" ";
+    const bool is_verbose   = action.flags.contains(EFlags(flag::types::CompileFlags::Verbose));
+
+    const flag::types::Compiler compiler = toolchain.kind;
+
+    if (!toolchain.pch) {  // only clang and gcc are probed for it
+        return plain;
+    }
+
+    /// key: the compiler, the flags that change how core.h parses and the installed core
+    const std::optional<u64> installed = core_version(core);
+
+    if (!installed.has_value()) {
+        return plain;
+    }
+
+    const std::string key = Fingerprint()
+                                .add(PCH_VERSION)
+                                .add(action.cxx_compiler)
+                                .add(toolchain.version)
+                                .add(language_flags)
+                                .add(*installed)
+                                .hex();
+
+    const std::optional<std::filesystem::path> cache = BuildCache::dir("pch");
+    std::error_code                            ec;
+
+    if (!cache.has_value()) {
+        return plain;
+    }
+
+    const std::filesystem::path dir = *cache / key;
+
+    /// clang is pointed at the pch directly, gcc picks up `core.h.gch` next to the `core.h` it is
+    /// told to include, and falls back to parsing that stub (and so the real core.h) if it can not
+    /// use it
+    const bool                  is_clang = compiler == flag::types::Compiler::Clang;
+    const std::filesystem::path stub     = dir / "core.h";
+    const std::filesystem::path pch      = dir / (is_clang ? "core.h.pch" : "core.h.gch");
+    const std::filesystem::path failed   = dir / "failed";
+    const std::string           use =
+        make_command(compiler,
+                     cxx::flags::includePCHFlag,
+                     "\"" + (is_clang ? pch : stub).generic_string() + "\"");
+
+    if (std::filesystem::exists(failed, ec)) {  // do not retry a header that did not build
+        return plain;
+    }
+
+    if (std::filesystem::exists(pch, ec)) {
+        return use;
+    }
+
+    std::filesystem::create_directories(dir, ec);
+
+    if (ec) {
+        return plain;
+    }
+
+    if (!is_clang) {
+        const std::filesystem::path tmp = BuildCache::scratch(stub);
+
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            out << "#include \"" << core.generic_string() << "\"\n";
+        }
+
+        if (!BuildCache::publish(tmp, stub)) {
+            return plain;
+        }
+    }
+
+    const std::filesystem::path tmp = BuildCache::scratch(pch);
+    const std::string           cmd =
+        action.cxx_compiler + " " +
+        make_command(compiler, cxx::flags::cxxHeaderFlag) + language_flags +
+        make_command(compiler, cxx::flags::outputFlag, "\"" + tmp.generic_string() + "\"") +
+        "\"" + (is_clang ? core : stub).generic_string() + "\" 2>&1";
+
+    const ExecResult result = exec(cmd);
+
+    if (is_verbose) {
+        helix::log<LogLevel::Debug>("precompile command: " + cmd);
+        helix::log<LogLevel::Debug>("precompile output:\n" + result.output);
+    }
+
+    if (result.return_code != 0) {
+        std::filesystem::remove(tmp, ec);
+        std::ofstream{failed};
+
+        helix::log_opt<LogLevel::Warning>(is_verbose,
+                                          "could not precompile core.h, parsing it every compile");
+        return plain;
+    }
+
+    return BuildCache::publish(tmp, pch) ? use : plain;
+}
+
+std::optional<u64> CXIRCompiler::core_version(const std::filesystem::path &core) {
+    Fingerprint     hash;
+    std::error_code ec;
+
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(
+             core.parent_path(), std::filesystem::directory_options::skip_permission_denied, ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+
+        const auto size  = entry.file_size(ec);
+        const auto mtime = entry.last_write_time(ec).time_since_epoch().count();
+
+        hash.add(entry.path().generic_string()).add(size).add(mtime);
+    }
+
+    return ec ? std::nullopt : std::optional(hash.value());
+}
@@ -0,0 +1,181 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/fingerprint.hh"
+#include "controller/include/shared/logger.hh"
+#include "controller/include/tooling/tooling.hh"
+#include "parser/preprocessor/include/preprocessor.hh"
+
+namespace {
+constexpr auto STAMP  = "helix-pgo.txt";    // hash of the cx-ir the profile is recorded for
+constexpr auto MERGED = "merged.profdata";  // clang's raw profiles, merged by llvm-profdata
+
+/// \returns the stamp of `dir`, empty if it has none
+std::string read_stamp(const std::filesystem::path &dir) {
+    std::ifstream in(dir / STAMP);
+    std::string   stamp;
+
+    in >> stamp;
+    return stamp;
+}
+}  // namespace
+
+std::string CXIRCompiler::pgo_flags(const CXXCompileAction &action, const Toolchain &toolchain) {
+    const BuildProfile &profile    = action.profile;
+    bool                is_verbose = action.flags.contains(flag::types::CompileFlags::Verbose);
+
+    if (profile.profile_generate.empty() && profile.profile_use.empty()) {
+        return "";
+    }
+
+    if (toolchain.kind != flag::types::Compiler::Clang &&
+        toolchain.kind != flag::types::Compiler::GCC) {
+        helix::log<LogLevel::Warning>("profile guided optimization needs clang or gcc, ignoring");
+        return "";
+    }
+
+    /// the cx-ir is what the compiler profiles, a change to it makes the profile stale
+    Fingerprint source;
+    source.add(__CONTROLLER_FS_N::read_file(action.cc_source.generic_string()));
+
+    for (const auto &part : action.parts) {
+        source.add(__CONTROLLER_FS_N::read_file(part.cc_source.generic_string()));
+    }
+
+    for (const auto &import : COMPILE_ACTIONS) {
+        source.add(__CONTROLLER_FS_N::read_file(import.cc_source.generic_string()));
+    }
+
+    std::error_code ec;
+
+    if (!profile.profile_generate.empty()) {
+        const std::filesystem::path &dir = profile.profile_generate;
+
+        std::filesystem::create_directories(dir, ec);
+
+        if (ec) {
+            helix::log<LogLevel::Error>("could not create the profile directory " +
+                                        dir.generic_string() + ": " + ec.message());
+            return "";
+        }
+
+        // runs of an instrumented build of the same cx-ir add up, older profiles are dropped.
+        // only what the compilers record is removed, the directory may hold anything else
+        if (read_stamp(dir) != source.hex()) {
+            std::vector<std::filesystem::path> stale;
+
+            // gcc mirrors the object paths below `dir`, its .gcda files can be nested
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(
+                     dir, std::filesystem::directory_options::skip_permission_denied, ec)) {
+                const std::filesystem::path &path = entry.path();
+
+                if (entry.is_regular_file(ec) &&
+                    (path.extension() == ".profraw" || path.extension() == ".gcda" ||
+                     path.filename() == MERGED)) {
+                    stale.push_back(path);
+                }
+            }
+
+            for (const auto &path : stale) {
+                std::filesystem::remove(path, ec);
+            }
+
+            std::ofstream(dir / STAMP, std::ios::trunc) << source.hex() << '\n';
+        }
+
+        helix::log_opt<LogLevel::Info>(
+            is_verbose, "instrumented build, its runs record to " + dir.generic_string());
+
+        return "-fprofile-generate=\"" + dir.generic_string() + "\" ";
+    }
+
+    if (!std::filesystem::exists(profile.profile_use, ec)) {
+        helix::log<LogLevel::Error>("profile not found: " + profile.profile_use.generic_string());
+        return "";
+    }
+
+    /// a .profdata file is used as is, a directory is what `profile_generate` recorded into
+    const bool            merged_file = std::filesystem::is_regular_file(profile.profile_use, ec);
+    std::filesystem::path dir         = merged_file ? profile.profile_use.parent_path()
+                                                    : profile.profile_use;
+    std::filesystem::path data        = merged_file ? profile.profile_use : dir;
+
+    const std::string stamp = read_stamp(dir);
+
+    if (stamp.empty()) {
+        helix::log_opt<LogLevel::Warning>(
+            is_verbose, "the profile has no " + std::string(STAMP) + ", it may be stale");
+    } else if (stamp != source.hex()) {
+        helix::log<LogLevel::Warning>(
+            "the profile in " + dir.generic_string() +
+            " was recorded for a different build of this source, rebuild with "
+            "--profile-generate and run it again. building without it");
+        return "";
+    }
+
+    if (toolchain.kind == flag::types::Compiler::Clang && !merged_file) {
+        const std::filesystem::path merged = dir / MERGED;
+        const auto                  since  = std::filesystem::last_write_time(merged, ec);
+        const bool                  have   = !ec;
+        std::vector<std::string>    raw;
+        bool                        newer = false;
+
+        for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+            if (entry.path().extension() == ".profraw") {
+                raw.push_back(entry.path().generic_string());
+                newer = newer || !have || entry.last_write_time(ec) > since;
+            }
+        }
+
+        if (newer) {  // only merged again when a run recorded something since
+            std::string cmd = "llvm-profdata merge -o \"" + merged.generic_string() + "\"";
+
+            for (const auto &file : raw) {
+                cmd += " \"" + file + "\"";
+            }
+
+            const ExecResult result = exec(cmd + " 2>&1");
+
+            if (is_verbose) {
+                helix::log<LogLevel::Debug>("merge command: " + cmd);
+                helix::log<LogLevel::Debug>("merge output:\n" + result.output);
+            }
+
+            if (result.return_code != 0) {
+                helix::log<LogLevel::Warning>(
+                    "could not merge the raw profiles with llvm-profdata:\n" + result.output);
+            }
+        }
+
+        if (!std::filesystem::exists(merged, ec)) {
+            helix::log<LogLevel::Warning>("no merged profile in " + dir.generic_string() +
+                                          ", building without it");
+            return "";
+        }
+
+        data = merged;
+    }
+
+    // functions the runs never reached are expected, only the hot ones get a profile
+    return "-fprofile-use=\"" + data.generic_string() + "\" " +
+           (toolchain.kind == flag::types::Compiler::Clang ? "-Wno-profile-instr-unprofiled "
+                                                           : "");
+}
@@ -0,0 +1,174 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "controller/include/shared/fingerprint.hh"
+#include "controller/include/tooling/tooling.hh"
+
+namespace {
+constexpr u64 TOOLCHAIN_VERSION = 1;  // bump when a probe is added or changed
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+constexpr char PATH_SEPARATOR = ';';
+constexpr auto EXE_SUFFIX     = ".exe";
+#else
+constexpr char PATH_SEPARATOR = ':';
+constexpr auto EXE_SUFFIX     = "";
+#endif
+
+/// \returns the executable `compiler` runs, following symlinks, nullopt if it is not found
+std::optional<std::filesystem::path> locate(const std::string &compiler) {
+    std::error_code ec;
+
+    if (compiler.find_first_of("/\\") != std::string::npos) {
+        auto path = std::filesystem::canonical(compiler, ec);
+        return ec ? std::nullopt : std::optional(path);
+    }
+
+    const char *env = std::getenv("PATH");
+
+    if (env == nullptr) {
+        return std::nullopt;
+    }
+
+    std::string_view dirs = env;
+
+    while (!dirs.empty()) {
+        const size_t     end = std::min(dirs.find(PATH_SEPARATOR), dirs.size());
+        std::string_view dir = dirs.substr(0, end);
+
+        dirs.remove_prefix(std::min(end + 1, dirs.size()));
+
+        if (dir.empty()) {
+            continue;
+        }
+
+        auto path = std::filesystem::path(dir) / (compiler + EXE_SUFFIX);
+
+        if (std::filesystem::is_regular_file(path, ec)) {
+            path = std::filesystem::canonical(path, ec);
+            return ec ? std::nullopt : std::optional(path);
+        }
+    }
+
+    return std::nullopt;
+}
+}  // namespace
+
+std::optional<Toolchain> Toolchain::probe(const std::string &compiler) {
+    std::error_code ec;
+    Fingerprint     key;
+
+    key.add(TOOLCHAIN_VERSION).add(compiler);
+
+    // keyed on the executable itself, an upgrade or a switched alternative is probed again
+    if (auto path = locate(compiler)) {
+        const auto size  = std::filesystem::file_size(*path, ec);
+        const auto mtime = std::filesystem::last_write_time(*path, ec).time_since_epoch().count();
+
+        key.add(path->generic_string()).add(size).add(mtime);
+    }
+
+    const std::optional<std::filesystem::path> dir = BuildCache::dir("toolchain");
+    const std::filesystem::path cached = dir.has_value() ? *dir / (key.hex() + ".txt") : "";
+
+    if (dir.has_value()) {
+        std::ifstream in(cached);
+        Toolchain     found;
+        int           kind = 0;
+
+        // kind pch lto lld\n then the `--version` output
+        if (in >> kind >> found.pch >> found.lto >> found.lld && in.get() == '\n') {
+            found.kind    = static_cast<flag::types::Compiler>(kind);
+            found.version = std::string(std::istreambuf_iterator<char>(in), {});
+
+            return found;
+        }
+    }
+
+    CXIRCompiler::ExecResult version = CXIRCompiler::exec(compiler + " --version");
+
+    if (version.return_code != 0) {
+        return std::nullopt;
+    }
+
+    Toolchain probed;
+    probed.version = std::move(version.output);
+
+    if (probed.version.find("clang") != std::string::npos) {
+        probed.kind = flag::types::Compiler::Clang;
+    } else if (probed.version.find("gcc") != std::string::npos) {
+        probed.kind = flag::types::Compiler::GCC;
+    } else if (probed.version.find("msvc") != std::string::npos) {
+        probed.kind = flag::types::Compiler::MSVC;
+    } else if (probed.version.find("mingw") != std::string::npos) {
+        probed.kind = flag::types::Compiler::MingW;
+    }
+
+    // each capability is a tiny program built the way the driver would use it, in a directory
+    // only this process owns so a concurrent probe never builds or deletes inside it
+    const std::filesystem::path scratch =
+        BuildCache::scratch(std::filesystem::temp_directory_path(ec) / "helix-probe");
+    bool ready = !ec && std::filesystem::create_directory(scratch, ec) && !ec;
+
+    if (ready) {
+        const std::string source = (scratch / "probe.cc").generic_string();
+        const std::string header = (scratch / "probe.hh").generic_string();
+        const std::string output = (scratch / "probe.out").generic_string();
+
+        ready = static_cast<bool>(std::ofstream(source) << "int main() { return 0; }\n") &&
+                static_cast<bool>(std::ofstream(header) << "inline int probe() { return 0; }\n");
+
+        auto builds = [&](const std::string &flags, const std::string &input) {
+            return CXIRCompiler::exec(compiler + " " + flags + " \"" + input + "\" -o \"" +
+                                      output + "\" 2>&1")
+                       .return_code == 0;
+        };
+
+        if (ready && (probed.kind == flag::types::Compiler::Clang ||
+                      probed.kind == flag::types::Compiler::GCC)) {
+            probed.pch = builds(std::string(cxx::flags::cxxHeaderFlag.clang), header);
+            probed.lto = builds(std::string(cxx::flags::linkTimeOptimizationFlag.clang), source);
+            probed.lld = builds(std::string(cxx::flags::lldLinkerFlag.clang), source);
+        }
+
+        std::filesystem::remove_all(scratch, ec);
+    }
+
+    // a probe that could not set up its inputs reports no capabilities, which is not worth
+    // remembering; the next run probes again
+    if (ready && dir.has_value()) {
+        const std::filesystem::path tmp = BuildCache::scratch(cached);
+
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            out << static_cast<int>(probed.kind) << ' ' << probed.pch << ' ' << probed.lto << ' '
+                << probed.lld << '\n'
+                << probed.version;
+        }
+
+        BuildCache::publish(tmp, cached);
+    }
+
+    return probed;
+}
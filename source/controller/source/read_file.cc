@@ -16,8 +16,11 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "controller/include/shared/file_system.hh"
@@ -41,34 +44,48 @@ __CONTROLLER_FS_BEGIN {
         return std::nullopt;
     }
 
-    std::optional<std::string> get_line(const std::string &filename, u64 line) {
-        std::string source = __CONTROLLER_FS_N::read_file(filename);
-
-        u64 current_line = 1;
-        u64 start        = 0;
-        u64 end          = 0;
-
-        for (u64 i = 0; i < source.size(); ++i) {
-            if (source[i] == '\n') {
-                ++current_line;
-                if (current_line == line) {
-                    start = i + 1;
-                } else if (current_line == line + 1) {
-                    end = i;
-                    break;
-                }
-            }
+    std::unordered_map<std::string, std::shared_ptr<const LineIndex>> LineIndex::cache_;
+    std::mutex                                                        LineIndex::mutex_;
+
+    LineIndex::LineIndex(std::string source)
+        : source(std::move(source)) {
+        starts.push_back(0);
 
-            if (i == source.size() - 1) {
-                end = source.size();
+        for (size_t i = this->source.find('\n'); i != std::string::npos;
+             i        = this->source.find('\n', i + 1)) {
+            starts.push_back(i + 1);
+        }
+    }
+
+    std::shared_ptr<const LineIndex> LineIndex::of(const std::string &filename) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (auto cached = cache_.find(filename); cached != cache_.end()) {
+                return cached->second;
             }
         }
 
-        if (line > current_line) {
+        // built without the lock, if two threads race for a file the first one in is kept
+        auto index = std::make_shared<const LineIndex>(__CONTROLLER_FS_N::read_file(filename));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cache_.try_emplace(filename, std::move(index)).first->second;
+    }
+
+    std::optional<std::string_view> LineIndex::line(u64 line) const {
+        if (line == 0 || line > starts.size()) {
             return std::nullopt;
         }
 
-        return source.substr(start, end - start);
+        const size_t start = starts[line - 1];
+        const size_t end   = line < starts.size() ? starts[line] - 1 : source.size();
+
+        return std::string_view(source).substr(start, end - start);
+    }
+
+    std::optional<std::string_view> get_line(const std::string &filename, u64 line) {
+        return LineIndex::of(filename)->line(line);
     }
 
     std::string _internal_read_file(const std::string &filename) {
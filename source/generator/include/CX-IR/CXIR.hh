@@ -19,22 +19,60 @@
 #include <clang/Format/Format.h>
 #include <llvm/ADT/StringRef.h>
 
+#include <cctype>
 #include <filesystem>
 #include <memory>
 #include <optional>
-#include <regex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "generator/include/CX-IR/loc.hh"
 #include "generator/include/CX-IR/tokens.def"
+#include "generator/include/CX-IR/writer.hh"
 #include "generator/include/config/Gen_config.def"
 #include "neo-pprint/include/hxpprint.hh"
 #include "parser/ast/include/AST.hh"
 #include "parser/ast/include/nodes/AST_declarations.hh"
 
-const std::regex
-    double_semi_regexp(R"(;\r?\n\s*?;)");  // Matches any whitespace around the semicolons
+/// \returns `text` with every `;` that only has whitespace and a line break between it and the
+/// next `;` merged into one, so `;\n  ;` becomes `;`
+inline std::string collapse_double_semis(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        out.push_back(text[i]);
+
+        if (text[i] != ';') {
+            continue;
+        }
+
+        size_t next = i + 1;
+
+        if (next < text.size() && text[next] == '\r') {
+            ++next;
+        }
+
+        if (next >= text.size() || text[next] != '\n') {
+            continue;
+        }
+
+        while (next < text.size() && std::isspace(static_cast<unsigned char>(text[next])) != 0) {
+            ++next;
+        }
+
+        if (next < text.size() && text[next] == ';') {
+            i = next;  // drop the whitespace and the second `;`
+        }
+    }
+
+    return out;
+}
+
 inline std::string get_neo_clang_format_config() {
     return R"(
 Language:        Cpp
@@ -140,96 +178,141 @@ UseTab:          Never
 GENERATE_CXIR_TOKENS_ENUM_AND_MAPPING;
 
 __CXIR_CODEGEN_BEGIN {
+    /// a single emitted c++ token, stored by value in the emitter. keywords and punctuation take
+    /// their text from `cxir_tokens_map`, everything else is a slice of the emitter's text arena
+    /// and the source file is an index into a process wide table of interned file names.
     class CX_Token {
       private:
-        u64         line{};
-        u64         column{};
-        u64         length{};
+        static constexpr u32 STATIC_TEXT = UINT32_MAX;  // `size` of a token with no arena text
+
+        u32         line{};
+        u32         column{};
+        u32         length{};
+        u32         file{};    // see `intern_file`, 0 is the generated (location-less) file
+        u32         offset{};  // into the owning emitter's text arena
+        u32         size = STATIC_TEXT;
         cxir_tokens type{};
-        std::string file_name;
-        std::string value;
+
+        friend class CXIR;
 
       public:
         CX_Token() = default;
-        CX_Token(const token::Token &tok, cxir_tokens set_type)
-            : line(tok.line_number())
-            , column(tok.column_number())
-            , length(tok.length())
-            , type(set_type)
-            , file_name(std::filesystem::path(tok.file_name()).generic_string())
-            , value(std::string(tok.value())) {}
-
-        explicit CX_Token(cxir_tokens type)
-            : length(1)
-            , type(type)
-            , file_name("_H1HJA9ZLO_17.helix-compiler.cxir")
-            , value(cxir_tokens_map.at(type).has_value()
-                        ? std::string(cxir_tokens_map.at(type).value())
-                        : " /* Unknown Token */ ") {}
-
-        CX_Token(cxir_tokens type, std::string value)
-            : length(value.length())
-            , type(type)
-            , file_name("_H1HJA9ZLO_17.helix-compiler.cxir")
-            , value(std::move(value)) {}
-
-        CX_Token(cxir_tokens type, const token::Token &loc)
-            : line(loc.line_number())
-            , column(loc.column_number())
-            , length(loc.length())
-            , type(type)
-            , file_name(std::filesystem::path(loc.file_name()).generic_string())
-            , value(cxir_tokens_map.at(type).has_value()
-                        ? std::string(cxir_tokens_map.at(type).value())
-                        : " /* Unknown Token */ ") {}
-
-        CX_Token(cxir_tokens type, std::string value, const token::Token &loc)
-            : line(loc.line_number())
-            , column(loc.column_number())
-            , length(loc.length())
-            , type(type)
-            , file_name(std::filesystem::path(loc.file_name()).generic_string())
-            , value(std::move(value)) {}
-
-        CX_Token(const CX_Token &)            = default;
-        CX_Token(CX_Token &&)                 = delete;
-        CX_Token &operator=(const CX_Token &) = default;
-        CX_Token &operator=(CX_Token &&)      = delete;
-        ~CX_Token()                           = default;
-
-        [[nodiscard]] u64         get_line() const { return line; }
-        [[nodiscard]] u64         get_column() const { return column; }
-        [[nodiscard]] u64         get_length() const { return length; }
-        [[nodiscard]] cxir_tokens get_type() const { return type; }
-        [[nodiscard]] std::string get_file_name() const { return file_name; }
-        [[nodiscard]] std::string get_value() const { return value; }
-        [[nodiscard]] std::string to_CXIR() const {
-            if (value[0] == '#') {
-                return "\n" + value + " ";
-            }
 
-            return value + " ";
-        }
+        /// \returns the id of `file_name`, the same name always returns the same id
+        static u32 intern_file(const std::string &file_name);
 
-        [[nodiscard]] std::string to_clean_CXIR() const {
-            if (value[0] == '#') {
-                return value + " ";
-            }
-            return value + "\n";
+        /// \returns the (generic) file name `id` was interned from
+        static const std::string &file_at(u32 id);
+
+        /// \returns the text of a keyword or punctuation token
+        static std::string_view static_text(cxir_tokens type) {
+            return cxir_tokens_map.at(type).value_or(" /* Unknown Token */ ");
         }
+
+        [[nodiscard]] u64                get_line() const { return line; }
+        [[nodiscard]] u64                get_column() const { return column; }
+        [[nodiscard]] u64                get_length() const { return length; }
+        [[nodiscard]] cxir_tokens        get_type() const { return type; }
+        [[nodiscard]] const std::string &get_file_name() const { return file_at(file); }
+        [[nodiscard]] bool               has_static_text() const { return size == STATIC_TEXT; }
     };
 
     class CXIR : public __AST_VISITOR::Visitor {
+      public:
+        /// a half open range of token indices
+        using TokenRange = std::pair<size_t, size_t>;
+
+        /// how a program is spread over several translation units, see `split`
+        struct Split {
+            size_t                        parts = 0;  // 0 when the program has to stay one unit
+            std::vector<std::vector<u32>> owner;      // [unit in `units()` order][body] -> part
+        };
+
       private:
-        std::vector<std::unique_ptr<CX_Token>> tokens;
-        std::vector<generator::CXIR::CXIR>     imports;
-        std::filesystem::path                  core_dir;
-        bool                                   forward_only = false;
+        std::vector<CX_Token>              tokens;
+        std::string                        text;  // values of every non static token, back to back
+        std::string                        last_file_name;
+        u32                                last_file    = 0;
+        size_t                             unique_names = 0;  // restarts for each top level decl
+        std::string                        module_guard;  // one per source file
+        mutable std::optional<std::string> rendered;  // see `render`
+        mutable SourceMap                  rendered_map;
+        mutable std::optional<std::string> readable;  // see `render_readable`
+        std::filesystem::path              core_dir;
+        bool                               forward_only = false;
+
+        /// lowered once per module and shared by every unit that imports it
+        std::vector<std::shared_ptr<const CXIR>> imports;
+
+        std::vector<TokenRange> bodies;  // function bodies only one translation unit needs
+        bool splittable = true;  // false once a top level declaration can not be split at all
+
+        void store(CX_Token &token, std::string_view value) {
+            token.offset = static_cast<u32>(text.size());
+            token.size   = static_cast<u32>(value.size());
+            text.append(value);
+        }
+
+        /// \returns a name no other call made while lowering the current top level declaration
+        /// returns, the same source always gets the same names
+        std::string unique_name() { return "$_" + std::to_string(unique_names++); }
+
+        /// top level declarations are only emitted in parallel when there are at least this many
+        static constexpr size_t PARALLEL_EMIT_THRESHOLD = 64;
+
+        /// emits `declarations` in order, on a pool of emitters when there are enough of them
+        void emit_declarations(const __AST_N::NodeV<> &declarations);
+
+        /// records what a split build needs to know about the top level `decl`, whose tokens
+        /// start at `begin`
+        void note_declaration(const __AST_N::NodeT<> &decl, size_t begin);
+
+        /// records the body of `func`, whose tokens start at `begin`, when every translation unit
+        /// but one can do with its prototype
+        void note_body(const __AST_NODE::FuncDecl &func, size_t begin);
+
+        /// \returns an empty emitter that lowers the way this one does
+        [[nodiscard]] CXIR fork() const { return CXIR(forward_only); }
+
+        /// moves the tokens of `part` to the end of this unit
+        void splice(CXIR &part) {
+            const auto base = static_cast<u32>(text.size());
+
+            text.append(part.text);
+            tokens.reserve(tokens.size() + part.tokens.size());
+
+            for (CX_Token token : part.tokens) {
+                if (!token.has_static_text()) {
+                    token.offset += base;
+                }
+
+                tokens.push_back(token);
+            }
+
+            part.tokens.clear();
+            part.text.clear();
+        }
+
+        void locate(CX_Token &token, const token::Token &loc) {
+            token.line   = loc.line_number();
+            token.column = loc.column_number();
+            token.length = loc.length();
+
+            // nearly every token comes from the same file as the one before it, so skip the
+            // (shared, locked) file table when it does
+            if (loc.get_file_name() != last_file_name) {
+                last_file_name = loc.get_file_name();
+                last_file      = CX_Token::intern_file(last_file_name);
+            }
+
+            token.file = last_file;
+        }
 
       public:
-        explicit CXIR(bool forward_only = false, std::vector<generator::CXIR::CXIR> imports = {})
-            : imports(std::move(imports))
-            , forward_only(forward_only) {}
+        explicit CXIR(bool                                     forward_only = false,
+                      std::vector<std::shared_ptr<const CXIR>> imports      = {})
+            : forward_only(forward_only)
+            , imports(std::move(imports)) {}
 
         CXIR(const CXIR &)            = default;
         CXIR(CXIR &&)                 = default;
@@ -245,77 +328,238 @@ __CXIR_CODEGEN_BEGIN {
             }
 
             for (const auto &token : tokens) {
-                if (token->get_line() != 0) {
-                    return token->get_file_name();
+                if (token.get_line() != 0) {
+                    return token.get_file_name();
                 }
             }
 
             return std::nullopt;
         }
 
-        void append(std::unique_ptr<CX_Token> token) { tokens.push_back(std::move(token)); }
-        void append(cxir_tokens type) { tokens.push_back(std::make_unique<CX_Token>(type)); }
+        [[nodiscard]] std::string_view value_of(const CX_Token &token) const {
+            if (token.has_static_text()) {
+                return CX_Token::static_text(token.type);
+            }
+
+            return std::string_view(text).substr(token.offset, token.size);
+        }
+
+        /// a keyword or punctuation token with no source location
+        void append(cxir_tokens type) {
+            CX_Token &token = tokens.emplace_back();
+            token.type      = type;
+            token.length    = 1;
+        }
+
+        /// a keyword or punctuation token at the location of `loc`
+        void append(cxir_tokens type, const token::Token &loc) {
+            CX_Token &token = tokens.emplace_back();
+            locate(token, loc);
+            token.type = type;
+        }
+
+        /// a token spelled `value` with no source location
+        void append(cxir_tokens type, std::string_view value) {
+            CX_Token &token = tokens.emplace_back();
+            token.type      = type;
+            token.length    = static_cast<u32>(value.length());
+            store(token, value);
+        }
+
+        /// a token spelled `value` at the location of `loc`
+        void append(cxir_tokens type, std::string_view value, const token::Token &loc) {
+            CX_Token &token = tokens.emplace_back();
+            locate(token, loc);
+            token.type = type;
+            store(token, value);
+        }
+
+        /// a token spelled and located like the helix token `tok`
+        void append(const token::Token &tok, cxir_tokens type) {
+            CX_Token &token = tokens.emplace_back();
+            locate(token, tok);
+            token.type = type;
+            store(token, tok.get_value());
+        }
 
         std::string generate_CXIR() const;
 
-        template <const bool add_core = true>
-        [[nodiscard]] std::string to_CXIR() const {
-            std::string cxir;
+        /// writes the lowered tokens of this unit (not its imports) into `out`, recording where
+        /// each located token ends up in `map` when given one
+        /// \param omit sorted function bodies to write as `;`, leaving only their prototypes
+        void write_CXIR(CXIRWriter                 &out,
+                        SourceMap                  *map  = nullptr,
+                        std::span<const TokenRange> omit = {}) const;
+
+        /// \returns every unit a translation unit holds in the order they are written: the
+        /// imports, dependencies first, then this one
+        [[nodiscard]] std::vector<const CXIR *> units() const {
+            std::vector<const CXIR *>            all;
+            std::unordered_set<std::string_view> seen;
+
+            for_each_import([&](const CXIR &import) { all.push_back(&import); }, seen);
+            all.push_back(this);
+
+            return all;
+        }
+
+        /// spreads the program over at most `parts` translation units. each of them holds every
+        /// declaration, the function bodies are balanced between them by size. a program is
+        /// only split when every top level declaration is either free of definitions a second
+        /// unit would duplicate or a function whose body can be left to one unit.
+        [[nodiscard]] Split split(size_t parts) const;
+
+        /// writes translation unit `part` of `split`, the core and every unit included
+        void write_part(CXIRWriter  &out,
+                        const Split &split,
+                        u32          part,
+                        SourceMap   *map = nullptr) const;
+
+        /// \returns a rough upper bound on the size of the cx-ir of this unit alone
+        [[nodiscard]] size_t own_size() const { return text.size() + (tokens.size() * 8); }
+
+        /// \returns a rough upper bound on the size of the cx-ir of this unit and its imports,
+        /// counting a module reached along several import paths once
+        [[nodiscard]] size_t estimate_size() const {
+            size_t size = 0;
+
+            for (const CXIR *unit : units()) {
+                size += unit->own_size();
+            }
+
+            return size;
+        }
+
+        /// \returns the cx-ir of this unit (not its imports), lowered on the first call only.
+        /// the source map of the text, relative to its start, is kept in `rendered_map`
+        const std::string &render() const {
+            if (!rendered.has_value()) {
+                CXIRWriter out(own_size());
+                write_CXIR(out, &rendered_map);
+
+                rendered = out.take();
+            }
+
+            return *rendered;
+        }
+
+        /// calls `emit` with every unit this one imports, directly or not, dependencies first.
+        /// a module reached along several paths of the import graph is only passed the first
+        /// time, its include guard would drop every later copy anyway.
+        template <typename Emit>
+        void for_each_import(Emit &&emit, std::unordered_set<std::string_view> &seen) const {
+            for (const auto &import : imports) {
+                if (!import->module_guard.empty() && seen.contains(import->module_guard)) {
+                    continue;
+                }
+
+                import->for_each_import(emit, seen);
+
+                if (import->module_guard.empty() || seen.insert(import->module_guard).second) {
+                    emit(*import);
+                }
+            }
+        }
 
+        /// writes the whole translation unit, `map` (if any) gets the source map of all of it
+        template <const bool add_core = true>
+        void write(CXIRWriter &out, SourceMap *map = nullptr) const {
             if constexpr (add_core) {
-                cxir += get_core() + "\n" + get_imports<false>() + "\n";
-            } else {
-                cxir += get_imports<false>() + "\n";
+                out << get_core() << '\n';
             }
 
-            cxir += generate_CXIR();
+            std::unordered_set<std::string_view> seen;
+            for_each_import(
+                [&](const CXIR &import) {
+                    const size_t base = out.position();
+                    out << import.render();
+
+                    if (map != nullptr) {
+                        map->append(import.rendered_map, base);
+                    }
+                },
+                seen);
+
+            out << '\n';
+            write_CXIR(out, map);
+        }
+
+        template <const bool add_core = true>
+        [[nodiscard]] std::string to_CXIR() const {
+            CXIRWriter out(estimate_size());
+            write<add_core>(out);
+
+            std::string cxir = out.take();
 
             if (cxir.empty()) {
                 print("CXIR is empty after processing tokens.");
-                return cxir;
             }
 
             return cxir;
         }
 
         [[nodiscard]] std::string to_readable_CXIR() const {
-            std::string cxir = get_imports<true>() + "\n";
+            std::string                          cxir;
+            std::unordered_set<std::string_view> seen;
 
-            // Build the CXIR string from tokens
-            for (const auto &token : tokens) {
-                cxir += token->to_clean_CXIR();
-            }
+            // every unit is a self contained guarded block, so each is formatted on its own and
+            // only the first time it is asked for
+            for_each_import([&](const CXIR &import) { cxir += import.render_readable(); }, seen);
 
-            // If cxir is empty, log and return early
-            if (cxir.empty()) {
-                print("CXIR is empty after processing tokens.");
-                return cxir;
+            cxir += "\n";
+            cxir += render_readable();
+
+            return cxir;
+        }
+
+        /// \returns the formatted cx-ir of this unit (not its imports), formatted on the first
+        /// call only
+        const std::string &render_readable() const {
+            if (!readable.has_value()) {
+                std::string cxir;
+                append_readable(cxir);
+
+                if (cxir.empty()) {
+                    print("CXIR is empty after processing tokens.");
+                }
+
+                readable = cxir.empty() ? cxir : format_cxir(cxir);
             }
 
-            // Format the CXIR code
-            return format_cxir(cxir);
+            return *readable;
         }
 
-        [[nodiscard]] static std::string format_cxir(const std::string &cxir) {
-            // Get the configuration as a string
-            std::string config = get_neo_clang_format_config();
+        /// \returns the style `get_neo_clang_format_config` describes, parsed once per process
+        [[nodiscard]] static const clang::format::FormatStyle &format_style() {
+            static const clang::format::FormatStyle style = [] {
+                clang::format::FormatStyle parsed =
+                    clang::format::getGoogleStyle(clang::format::FormatStyle::LanguageKind::LK_Cpp);
+
+                auto error =
+                    clang::format::parseConfiguration(get_neo_clang_format_config(), &parsed);
+
+                if (error) {
+                    print("failed to parse configuration: ", error.message());
+                    throw std::runtime_error("Failed to parse configuration");
+                }
+
+                return parsed;
+            }();
 
-            // Use a basic clang format style to simplify testing
-            clang::format::FormatStyle style =
-                clang::format::getGoogleStyle(clang::format::FormatStyle::LanguageKind::LK_Cpp);
+            return style;
+        }
 
-            // Parse the configuration string into the FormatStyle object
-            auto error = clang::format::parseConfiguration(config, &style);
-            if (error) {
-                print("failed to parse configuration: ", error.message());
-                throw std::runtime_error("Failed to parse configuration");
+        /// \param ranges the parts of `cxir` to format, everything when empty
+        [[nodiscard]] static std::string
+        format_cxir(const std::string &cxir, std::vector<clang::tooling::Range> ranges = {}) {
+            if (ranges.empty()) {
+                ranges.emplace_back(0, cxir.size());
             }
 
             // Format the cxir code using the style
             llvm::StringRef              codeRef(cxir);
-            clang::tooling::Range        range(0, cxir.size());
             clang::tooling::Replacements replacements =
-                clang::format::reformat(style, codeRef, {range});
+                clang::format::reformat(format_style(), codeRef, ranges);
 
             // Apply the replacements to get the formatted code
             llvm::Expected<std::string> formattedCode =
@@ -326,24 +570,19 @@ __CXIR_CODEGEN_BEGIN {
                 throw std::runtime_error("Error formatting code");
             }
 
-            return std::regex_replace(*formattedCode, double_semi_regexp, ";");
+            return collapse_double_semis(*formattedCode);
         }
 
         static std::string get_core();
 
-        template <const bool readable>
-        std::string get_imports() const {
-            std::string cxir;
+        /// appends the tokens of this unit to `cxir`, one per line
+        void append_readable(std::string &cxir) const {
+            for (const auto &token : tokens) {
+                std::string_view value = value_of(token);
 
-            for (const auto &import : this->imports) {
-                if constexpr (readable) {
-                    cxir += import.to_readable_CXIR();
-                } else {
-                    cxir += import.to_CXIR<false>();
-                }
+                cxir += value;
+                cxir += (!value.empty() && value[0] == '#') ? ' ' : '\n';
             }
-
-            return cxir;
         }
 
         void visit(const parser::ast::node::LiteralExpr &node) override;
@@ -16,89 +16,104 @@
 #ifndef __CXIR_LOC_H__
 #define __CXIR_LOC_H__
 
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "generator/include/config/Gen_config.def"
-#include "neo-pprint/include/hxpprint.hh"
-#include "parser/ast/include/AST.hh"
+#include "neo-types/include/hxint.hh"
 
 __CXIR_CODEGEN_BEGIN {
+    /// a position in a helix source file, `file` indexes the file table of the owning map
     struct SourceLocation {
-        size_t line;
-        size_t column;
-        size_t length;
-
-        bool is_placeholder = false;
+        u32 file   = 0;
+        u32 line   = 0;
+        u32 column = 0;
+        u32 length = 0;
     };
 
+    /// maps byte offsets in emitted cx-ir back to the helix source they were lowered from. entries
+    /// are added in ascending offset order and kept in two parallel sorted arrays, so finding the
+    /// source of any offset is a binary search. on disk the map is delta encoded, see `serialize`.
     class SourceMap {
       public:
-        /// 2D map of line and column to SourceLocation
-        std::map<size_t, std::map<size_t, SourceLocation>> mappings;
+        /// \returns the index of `file_name` in the file table, adding it if it is new
+        u32 intern(const std::string &file_name) {
+            auto found = std::ranges::find(files, file_name);
+
+            if (found != files.end()) {
+                return static_cast<u32>(found - files.begin());
+            }
 
-        void append(const SourceLocation &helix_loc, size_t cxir_line, size_t cxir_col) {
-            mappings[cxir_line][cxir_col] = helix_loc;
+            files.push_back(file_name);
+            return static_cast<u32>(files.size() - 1);
         }
 
-        void debug_print() {
-            // print like: [(line, col) -> (line, col)]\n
-            for (const auto &line : mappings) {
-                for (const auto &col : line.second) {
-                    std::cout << "[(" << line.first << ", " << col.first << ") -> ("
-                              << col.second.line << ", " << col.second.column << ")]\n";
-                }
+        /// maps everything from `offset` up to the next entry to `loc`, offsets must not decrease
+        void add(size_t offset, SourceLocation loc) {
+            if (!offsets.empty() && offsets.back() == offset) {
+                locations.back() = loc;
+                return;
             }
+
+            offsets.push_back(static_cast<u32>(offset));
+            locations.push_back(loc);
         }
 
-        SourceLocation find_loc(size_t line, size_t col) {
-            // Check if the exact line and column mapping exists
-            auto line_iter = mappings.find(line);
-            if (line_iter != mappings.end()) {
-                auto &line_map = line_iter->second;
-                auto  col_iter = line_map.find(col);
-                if (col_iter != line_map.end()) {
-                    return col_iter->second;  // Exact match
-                }
+        /// adds every entry of `part`, as if it was written starting at `base`
+        void append(const SourceMap &part, size_t base) {
+            std::vector<u32> file_of;
+            file_of.reserve(part.files.size());
+
+            for (const auto &file_name : part.files) {
+                file_of.push_back(intern(file_name));
             }
 
-            // Find the nearest line
-            size_t nearest_line  = SIZE_MAX;
-            size_t min_line_diff = SIZE_MAX;
+            offsets.reserve(offsets.size() + part.offsets.size());
+            locations.reserve(locations.size() + part.locations.size());
 
-            for (const auto &[mapped_line, _] : mappings) {
-                size_t diff = (mapped_line > line) ? (mapped_line - line) : (line - mapped_line);
-                if (diff < min_line_diff || (diff == min_line_diff && mapped_line > nearest_line)) {
-                    nearest_line  = mapped_line;
-                    min_line_diff = diff;
-                }
-            }
+            for (size_t i = 0; i < part.offsets.size(); ++i) {
+                SourceLocation loc = part.locations[i];
+                loc.file           = file_of[loc.file];
 
-            if (nearest_line == SIZE_MAX) {
-                return SourceLocation{0, 0, 0, true};  // No lines found
+                add(base + part.offsets[i], loc);
             }
+        }
 
-            // Find the nearest column within the nearest line
-            const auto &nearest_line_map = mappings[nearest_line];
-            size_t      nearest_col      = SIZE_MAX;
-            size_t      min_col_diff     = SIZE_MAX;
-
-            for (const auto &[mapped_col, _] : nearest_line_map) {
-                size_t diff = (mapped_col > col) ? (mapped_col - col) : (col - mapped_col);
-                if (diff < min_col_diff || (diff == min_col_diff && mapped_col > nearest_col)) {
-                    nearest_col  = mapped_col;
-                    min_col_diff = diff;
-                }
-            }
+        /// \returns the location of the last entry at or before `offset`
+        [[nodiscard]] std::optional<SourceLocation> find(size_t offset) const {
+            auto after = std::ranges::upper_bound(offsets, offset);
 
-            if (nearest_col == SIZE_MAX) {
-                return SourceLocation{0, 0, 0, true};  // No columns found
+            if (after == offsets.begin()) {
+                return std::nullopt;
             }
 
-            // Return the nearest SourceLocation
-            return nearest_line_map.at(nearest_col);
+            return locations[static_cast<size_t>(after - offsets.begin()) - 1];
         }
-    };
 
-    inline std::unordered_map<std::string, SourceMap>
-        SOURCE_MAPS;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+        [[nodiscard]] const std::string &file(u32 index) const { return files.at(index); }
+        [[nodiscard]] size_t             size() const { return offsets.size(); }
+        [[nodiscard]] bool               empty() const { return offsets.empty(); }
+
+        [[nodiscard]] bool has_file(std::string_view file_name) const {
+            return std::ranges::find(files, file_name) != files.end();
+        }
+
+        /// \returns the map in its binary form: the magic `HXSM`, a version byte, the file table
+        /// and then one record per entry, every field an unsigned leb128 and offsets and lines
+        /// stored as the difference to the entry before (lines zigzag encoded).
+        [[nodiscard]] std::string serialize() const;
+
+        /// \returns the map `data` holds, nullopt if it is not a map `serialize` wrote
+        [[nodiscard]] static std::optional<SourceMap> deserialize(std::string_view data);
+
+      private:
+        std::vector<std::string>    files;
+        std::vector<u32>            offsets;  // sorted, parallel to `locations`
+        std::vector<SourceLocation> locations;
+    };
 }  // namespace __CXIR_CODEGEN_END
 
-#endif  // __CXIR_LOC_H__
\ No newline at end of file
+#endif  // __CXIR_LOC_H__
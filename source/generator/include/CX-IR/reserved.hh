@@ -33,7 +33,7 @@ __CXIR_CODEGEN_BEGIN {
         std::map<std::string, std::function<void(CXIR *, const __TOKEN_N::Token &)>>;
 
     void basic_name_transform(CXIR *self, const __TOKEN_N::Token &token) {
-        self->append(std::make_unique<CX_Token>(CXX_CORE_IDENTIFIER, "_H_RESERVED$" + token.value(), token));
+        self->append(CXX_CORE_IDENTIFIER, "_H_RESERVED$" + token.value(), token);
     }
 
     TransformMap reserved_transformations{
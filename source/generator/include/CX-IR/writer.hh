@@ -0,0 +1,91 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __CXIR_WRITER_H__
+#define __CXIR_WRITER_H__
+
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "generator/include/config/Gen_config.def"
+
+__CXIR_CODEGEN_BEGIN {
+    /// append only output for cx-ir. everything is written into one buffer reserved up front, with
+    /// a sink attached the buffer is handed over in large blocks so a whole translation unit is
+    /// never held in memory at once.
+    class CXIRWriter {
+      public:
+        static constexpr size_t FLUSH_AT = size_t{1} << 20;  // 1 MiB
+
+        explicit CXIRWriter(size_t expected_size = 0, std::ostream *sink = nullptr)
+            : sink(sink) {
+            buffer.reserve(sink != nullptr ? std::min(expected_size, FLUSH_AT * 2) : expected_size);
+        }
+
+        CXIRWriter(const CXIRWriter &)            = delete;
+        CXIRWriter(CXIRWriter &&)                 = delete;
+        CXIRWriter &operator=(const CXIRWriter &) = delete;
+        CXIRWriter &operator=(CXIRWriter &&)      = delete;
+        ~CXIRWriter() { flush(); }
+
+        CXIRWriter &operator<<(std::string_view text) {
+            buffer.append(text);
+
+            if (sink != nullptr && buffer.size() >= FLUSH_AT) {
+                flush();
+            }
+
+            return *this;
+        }
+
+        CXIRWriter &operator<<(char chr) {
+            buffer.push_back(chr);
+            return *this;
+        }
+
+        CXIRWriter &write_number(size_t number) {
+            char buf[24];
+            auto [end, _] = std::to_chars(buf, buf + sizeof(buf), number);
+
+            buffer.append(buf, end);
+            return *this;
+        }
+
+        /// hand whatever is buffered to the sink, a no-op without one
+        void flush() {
+            if (sink != nullptr && !buffer.empty()) {
+                sink->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                flushed += buffer.size();
+                buffer.clear();
+            }
+        }
+
+        /// \returns the number of bytes written so far, flushed or not
+        [[nodiscard]] size_t position() const { return flushed + buffer.size(); }
+
+        /// \returns everything written so far, only meaningful without a sink
+        [[nodiscard]] std::string take() { return std::move(buffer); }
+
+      private:
+        std::string   buffer;
+        std::ostream *sink    = nullptr;
+        size_t        flushed = 0;
+    };
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_WRITER_H__
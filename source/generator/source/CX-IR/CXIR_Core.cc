@@ -13,11 +13,51 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include "controller/include/shared/file_system.hh"
 #include "controller/include/shared/logger.hh"
 
 #include "utils.hh"
 
+namespace {
+    /// every file name a cx-ir token has pointed at, id 0 is the compiler generated file
+    struct FileTable {
+        std::mutex                           lock;
+        std::deque<std::string>              names{"_H1HJA9ZLO_17.helix-compiler.cxir"};
+        std::unordered_map<std::string, u32> ids{{"_H1HJA9ZLO_17.helix-compiler.cxir", 0}};
+    };
+
+    FileTable &file_table() {
+        static FileTable table;
+        return table;
+    }
+}  // namespace
+
+u32 __CXIR_CODEGEN_N::CX_Token::intern_file(const std::string &file_name) {
+    FileTable       &table = file_table();
+    std::scoped_lock guard(table.lock);
+
+    if (auto it = table.ids.find(file_name); it != table.ids.end()) {
+        return it->second;
+    }
+
+    auto id = static_cast<u32>(table.names.size());
+    table.names.push_back(std::filesystem::path(file_name).generic_string());
+    table.ids.emplace(file_name, id);
+
+    return id;
+}
+
+const std::string &__CXIR_CODEGEN_N::CX_Token::file_at(u32 id) {
+    FileTable       &table = file_table();
+    std::scoped_lock guard(table.lock);
+
+    return table.names.at(id);  // deque never moves its elements on push_back
+}
+
 std::string read_core_lib() {
     std::filesystem::path core_lib = std::filesystem::path(__FILE__).parent_path() / "core_lib.hh";
     std::ifstream         file(core_lib);
@@ -82,9 +122,6 @@ std::string __CXIR_CODEGEN_N::CXIR::get_core() {
 ///  Copyright (c) 2024 (CC BY 4.0)
 ///
 ///  This file was generated by the Helix compiler, do not modify it directly.
-///  Generated on: )" +
-        std::to_string(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())) +
-        R"( [unix-timestamp]
 ///
 ///*--- Helix ---*
 
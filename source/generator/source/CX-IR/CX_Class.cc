@@ -120,11 +120,11 @@ CX_VISIT_IMPL(ClassDecl) {
                         add_public(self);
                         token::Token marker = ((op_t.tok == nullptr) ? node.name->name : *op_t.tok);
                     
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_TILDE, marker));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_CORE_IDENTIFIER,
-                                                                node.name->name.value(), marker));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
+                        self->append(cxir_tokens::CXX_TILDE, marker);
+                        self->append(cxir_tokens::CXX_CORE_IDENTIFIER,
+                                     node.name->name.value(), marker);
+                        self->append(cxir_tokens::CXX_LPAREN);
+                        self->append(cxir_tokens::CXX_RPAREN);
 
                         self->visit(*op_decl->func->body);
 
@@ -215,7 +215,7 @@ CX_VISIT_IMPL(ClassDecl) {
         }
 
         auto add_token = [this, &loc](const cxir_tokens &tok) {
-            this->append(std::make_unique<CX_Token>(tok, loc));
+            this->append(tok, loc);
         };
 
         /// class Foo::<T> extends Bar::<T> requires <T> {}
@@ -260,11 +260,10 @@ CX_VISIT_IMPL(ClassDecl) {
             extend->accept(*this);
             add_token(cxir_tokens::CXX_COMMA);
 
-            this->append(std::make_unique<CX_Token>(cxir_tokens::CXX_CORE_LITERAL,
-                                                    "\"" + node.name->name.value() +
-                                                        " must satisfy " + extend->marker.value() +
-                                                        " interface\"",
-                                                    loc));
+            this->append(cxir_tokens::CXX_CORE_LITERAL,
+                         "\"" + node.name->name.value() + " must satisfy " +
+                             extend->marker.value() + " interface\"",
+                         loc);
             add_token(cxir_tokens::CXX_RPAREN);
             add_token(cxir_tokens::CXX_SEMICOLON);
         }
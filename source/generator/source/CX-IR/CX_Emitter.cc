@@ -13,7 +13,12 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "generator/include/config/Gen_config.def"
 #include "parser/ast/include/AST.hh"
@@ -31,15 +36,16 @@ void generator::CXIR::CXIR::visit(__AST_NODE::Program &node) {
     });
 
     std::string _namespace = sanitize_string(node.get_file_name());
+    module_guard           = _namespace + "_M";
 
     error::NAMESPACE_MAP[_namespace] =
         sanitize_string(std::filesystem::path(node.get_file_name()).stem().generic_string());
 
     // insert header guards
     ADD_TOKEN(CXX_PP_IFNDEF);
-    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, _namespace + "_M");
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, module_guard);
     ADD_TOKEN(CXX_PP_DEFINE);
-    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, _namespace + "_M");
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, module_guard);
 
     ADD_TOKEN_AT_LOC(
         CXX_NAMESPACE,
@@ -63,6 +69,7 @@ void generator::CXIR::CXIR::visit(__AST_NODE::Program &node) {
     }
 
     __AST_N::NodeT<__AST_NODE::FuncDecl> main_func = nullptr;
+    __AST_N::NodeV<>                     declarations;  // everything but main, in source order
 
     std::for_each(node.children.begin(), node.children.end(), [&](const auto &child) {
         if (child->getNodeType() == __AST_NODE::nodes::FuncDecl) {
@@ -94,17 +101,18 @@ void generator::CXIR::CXIR::visit(__AST_NODE::Program &node) {
                     return;
                 }
             }
-        } else if (child->getNodeType() == __AST_NODE::nodes::LetDecl) {
-            __AST_N::NodeT<__AST_NODE::LetDecl> node = __AST_N::as<__AST_NODE::LetDecl>(child);
-            visit(*node, true);
-            return;
         }
 
-        child->accept(*this);
+        declarations.push_back(child);
     });
 
+    emit_declarations(declarations);
+
     if (main_func != nullptr) {
+        size_t begin = tokens.size();
+
         main_func->accept(*this);
+        note_body(*main_func, begin);
 
         if (!trivially_import) {
             ADD_TOKEN(CXX_RBRACE);  // end namespace _namespace
@@ -174,7 +182,10 @@ void generator::CXIR::CXIR::visit(__AST_NODE::Program &node) {
             main_func->body->body->body.push_back(ret);  // return helix::...::...(..., ...);
         }
 
+        begin = tokens.size();
+
         main_func->accept(*this);
+        note_body(*main_func, begin);
     } else {
         if (!trivially_import) {
             ADD_TOKEN(CXX_RBRACE);  // end namespace _namespace
@@ -183,5 +194,122 @@ void generator::CXIR::CXIR::visit(__AST_NODE::Program &node) {
         ADD_TOKEN(CXX_RBRACE);  // end namespace helix
     }
 
-    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "#endif");
+    ADD_TOKEN(CXX_PP_ENDIF);
+}
+
+void generator::CXIR::CXIR::emit_declarations(const __AST_N::NodeV<> &declarations) {
+    auto emit = [](CXIR &emitter, const __AST_N::NodeT<> &decl) {
+        if (decl->getNodeType() == __AST_NODE::nodes::LetDecl) {
+            emitter.visit(*__AST_N::as<__AST_NODE::LetDecl>(decl), true);
+            return;
+        }
+
+        decl->accept(emitter);
+    };
+
+    const size_t count   = declarations.size();
+    const size_t workers = std::min<size_t>(std::thread::hardware_concurrency(), count);
+
+    if (count < PARALLEL_EMIT_THRESHOLD || workers < 2) {
+        for (const auto &decl : declarations) {
+            const size_t begin = tokens.size();
+
+            unique_names = 0;  // as if it had its own emitter, like below
+            emit(*this, decl);
+            note_declaration(decl, begin);
+        }
+
+        return;
+    }
+
+    // every declaration gets its own emitter, they are spliced back in source order so the
+    // output does not depend on how the work was scheduled
+    std::vector<CXIR>               parts;
+    std::vector<std::exception_ptr> failures(count);
+    std::atomic<size_t>             next = 0;
+
+    parts.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        parts.push_back(fork());
+    }
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers);
+
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([&] {
+                for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                    try {
+                        emit(parts[i], declarations[i]);
+                    } catch (...) {
+                        failures[i] = std::current_exception();
+                    }
+                }
+            });
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (failures[i] != nullptr) {
+            std::rethrow_exception(failures[i]);
+        }
+
+        const size_t begin = tokens.size();
+
+        splice(parts[i]);
+        note_declaration(declarations[i], begin);
+    }
+}
+
+void generator::CXIR::CXIR::note_declaration(const __AST_N::NodeT<> &decl, size_t begin) {
+    switch (decl->getNodeType()) {
+        case __AST_NODE::nodes::FuncDecl:
+            note_body(*__AST_N::as<__AST_NODE::FuncDecl>(decl), begin);
+            return;
+
+        // types, concepts and operators only define inline members, constants have internal
+        // linkage, so every translation unit can have its own copy
+        case __AST_NODE::nodes::ClassDecl:
+        case __AST_NODE::nodes::StructDecl:
+        case __AST_NODE::nodes::EnumDecl:
+        case __AST_NODE::nodes::TypeDecl:
+        case __AST_NODE::nodes::InterDecl:
+        case __AST_NODE::nodes::ExtendDecl:
+        case __AST_NODE::nodes::OpDecl:
+        case __AST_NODE::nodes::ConstDecl:
+            return;
+
+        default:  // variables, modules, ...: a second copy would be a second definition
+            splittable = false;
+            return;
+    }
+}
+
+void generator::CXIR::CXIR::note_body(const __AST_NODE::FuncDecl &func, size_t begin) {
+    // templates, inline, constexpr and internal functions are fine in every translation unit
+    if (func.generics != nullptr || func.body == nullptr ||
+        func.modifiers.contains(__TOKEN_N::KEYWORD_INLINE) ||
+        func.modifiers.contains(__TOKEN_N::KEYWORD_STATIC) ||
+        func.modifiers.contains(__TOKEN_N::KEYWORD_EVAL) ||
+        func.modifiers.contains(__TOKEN_N::KEYWORD_CONST)) {
+        return;
+    }
+
+    // the body is the last thing a function lowers to, find the brace that opens it
+    if (tokens.size() > begin && tokens.back().get_type() == CXX_RBRACE) {
+        size_t depth = 0;
+
+        for (size_t i = tokens.size(); i-- > begin;) {
+            if (tokens[i].get_type() == CXX_RBRACE) {
+                ++depth;
+            } else if (tokens[i].get_type() == CXX_LBRACE && --depth == 0) {
+                bodies.emplace_back(i, tokens.size());
+                return;
+            }
+        }
+    }
+
+    splittable = false;
 }
@@ -163,8 +163,9 @@ CX_VISIT_IMPL(UnaryExpr) {
 
 CX_VISIT_IMPL(IdentExpr) {
     // if self then set to (*this)
-    if (reserved_transformations.contains(node.name.value())) {
-        reserved_transformations[node.name.value()](this, node.name);
+    if (auto transform = reserved_transformations.find(node.name.value());
+        transform != reserved_transformations.end()) {
+        transform->second(this, node.name);
         return;
     }
     
@@ -72,7 +72,7 @@ CX_VISIT_IMPL(InterDecl) {
     };
 
     token::Token self           = node.name->name;
-    std::string  self_parm_name = generate_unique_name();
+    std::string  self_parm_name = unique_name();
     std::unordered_map<__AST_N::NodeT<__AST_NODE::VarDecl> *, std::string> type_map;
 
     auto self_tok = __AST_N::make_node<__AST_NODE::RequiresParamDecl>(
@@ -128,7 +128,7 @@ CX_VISIT_IMPL(InterDecl) {
                             continue;
                         }
 
-                        type_map[&param] = generate_unique_name();
+                        type_map[&param] = unique_name();
                     }
                 }
 
@@ -168,7 +168,7 @@ CX_VISIT_IMPL(InterDecl) {
                             continue;
                         }
 
-                        type_map[&param] = generate_unique_name();
+                        type_map[&param] = unique_name();
                     }
                 }
 
@@ -204,7 +204,7 @@ CX_VISIT_IMPL(IfState) {
     if (node.body != nullptr) {
         node.body->accept(*this);
     } else {
-        tokens.push_back(std ::make_unique<CX_Token>(cxir_tokens ::CXX_SEMICOLON));
+        append(cxir_tokens ::CXX_SEMICOLON);
     };
 
     if (node.has_eval && !node.has_const) {
@@ -383,7 +383,7 @@ CX_VISIT_IMPL(BlockState) {
                 }
             }
 
-            tokens.push_back(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+            append(cxir_tokens::CXX_SEMICOLON);
         }
     }
 }
@@ -428,7 +428,7 @@ CX_VISIT_IMPL(FinallyState) {
     ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "helix");
     ADD_TOKEN(CXX_SCOPE_RESOLUTION);
     ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "$finally");
-    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_" + generate_unique_name());
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_" + unique_name());
     ADD_TOKEN(CXX_LPAREN);
     ADD_TOKEN(CXX_LBRACKET);
     ADD_TOKEN(CXX_AMPERSAND);
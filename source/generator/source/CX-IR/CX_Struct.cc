@@ -97,11 +97,11 @@ CX_VISIT_IMPL(StructDecl) {
                         add_public(self);
                         token::Token marker = ((op_t.tok == nullptr) ? node.name->name : *op_t.tok);
                     
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_TILDE, marker));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_CORE_IDENTIFIER,
-                                                                node.name->name.value(), marker));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-                        self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
+                        self->append(cxir_tokens::CXX_TILDE, marker);
+                        self->append(cxir_tokens::CXX_CORE_IDENTIFIER,
+                                     node.name->name.value(), marker);
+                        self->append(cxir_tokens::CXX_LPAREN);
+                        self->append(cxir_tokens::CXX_RPAREN);
 
                         self->visit(*op_decl->func->body);
 
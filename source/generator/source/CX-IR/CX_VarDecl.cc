@@ -16,8 +16,16 @@
 #include "utils.hh"
 
 CX_VISIT_IMPL(ConstDecl) {
+    // const eval -> constexpr, so the value is usable in array sizes and template arguments
+    const bool is_eval = node.modifiers.contains(token::KEYWORD_EVAL);
+
     for (const auto &param : node.vars) {
-        ADD_TOKEN(CXX_CONST);
+        if (is_eval) {
+            ADD_TOKEN_AT_LOC(CXX_CONSTEXPR, node.modifiers.get(token::KEYWORD_EVAL));
+        } else {
+            ADD_TOKEN(CXX_CONST);
+        }
+
         param->accept(*this);
     };
 }
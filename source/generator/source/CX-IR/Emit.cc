@@ -13,6 +13,8 @@
 ///                                                                                              ///
 ///-------------------------------------------------------------------------------------- C++ ---///
 
+#include <array>
+
 #include "generator/include/CX-IR/loc.hh"
 #include "neo-panic/include/error.hh"
 #include "neo-types/include/hxint.hh"
@@ -20,8 +22,6 @@
 #include "token/include/private/Token_base.hh"
 #include "utils.hh"
 
-static size_t f_index = 0;
-
 __CXIR_CODEGEN_BEGIN {
     std::string normalize_file_name(std::string file_name) {
         if (file_name.empty()) {
@@ -37,101 +37,104 @@ __CXIR_CODEGEN_BEGIN {
         return file_name;
     }
 
-    void handle_file_change(std::string & file_name,
-                            const std::unique_ptr<CX_Token> &token,
-                            SourceMap                       &source_map,
-                            size_t                          &cxir_line,
-                            size_t                          &cxir_col) {
-
-        if (normalize_file_name(file_name) == normalize_file_name(token->get_file_name())) {
-            return;
+    /// how the writer lays out a preprocessor directive, the emitter always gives directives their
+    /// own `CXX_PP_*` kind so the text of a token never has to be looked at
+    enum class Directive : u8 {
+        None,
+        Single,       // #endif, #else
+        Pair,         // the directive and the token after it: #include <...>, #define X, ...
+        Conditional,  // #if (...), #elif (...)
+    };
+
+    constexpr auto DIRECTIVES = [] {
+        std::array<Directive, CXX_TOKENS_COUNT> table{};
+
+        table[CXX_PP_ENDIF] = Directive::Single;
+        table[CXX_PP_ELSE]  = Directive::Single;
+
+        for (auto kind : {CXX_PP_INCLUDE,
+                          CXX_PP_DEFINE,
+                          CXX_PP_IFDEF,
+                          CXX_PP_IFNDEF,
+                          CXX_PP_PRAGMA,
+                          CXX_PP_UNDEF,
+                          CXX_PP_ERROR,
+                          CXX_PP_WARNING,
+                          CXX_PP_LINE}) {
+            table[kind] = Directive::Pair;
         }
 
-        if (token && token->get_line() != 0 &&
-            !(normalize_file_name(token->get_file_name()).empty())) {
+        table[CXX_PP_IF]   = Directive::Conditional;
+        table[CXX_PP_ELIF] = Directive::Conditional;
 
-            file_name = token->get_file_name();
-            if (file_name.empty()) {
-                return;
-            }
+        return table;
+    }();
 
-            // cxir += "\n#line 1 R\"(" + file_name + ")\"\n";
+    inline Directive directive_of(const CX_Token &token) { return DIRECTIVES[token.get_type()]; }
 
-            if (SOURCE_MAPS.find(file_name) == SOURCE_MAPS.end()) {
-                SOURCE_MAPS[file_name] = SourceMap();
-            }
+    /// a token at most this many lines below the last one is reached with newlines, not `#line`
+    constexpr size_t MAX_LINE_GAP = 8;
 
-            source_map = SOURCE_MAPS[file_name];
+    std::string CXIR::generate_CXIR() const {
+        CXIRWriter out(own_size());
+        write_CXIR(out);
 
-            // reset the line and column
-            cxir_line = 1;
-            cxir_col  = 1;
-        }
+        return out.take();
     }
 
-    std::string get_file_name(const std::unique_ptr<CX_Token> &tok) {
-        if ((tok != nullptr) && (tok->get_line() != 0) &&
-            (!normalize_file_name(tok->get_file_name()).empty())) {
-            return tok->get_file_name();
-        }
+    void CXIR::write_CXIR(CXIRWriter &out, SourceMap *map, std::span<const TokenRange> omit) const {
+        /// layout: tokens of one source line share one output line, separated by a space. the
+        /// compiler is kept on the right source line by plain newlines when the next token is a
+        /// few lines further down, and by a `#line` only when the file changes, the source goes
+        /// backwards or skips a larger gap. exact columns are left to the source map.
 
-        return "";
-    }
+        std::map<string, string>        file_macros;
+        std::vector<const std::string *> macro_of;  // file id -> its macro, null if it has none
+        std::vector<u32>                 files;     // file ids in the order they first appear
+        std::vector<u32>                 map_file;  // file id -> its index in `map`
 
-    bool is_2_token_pp_directive(const std::unique_ptr<CX_Token> &token) {
-        return (token->get_value() == "#include" ||
-                token->get_type() == cxir_tokens::CXX_PP_INCLUDE) ||
-               (token->get_value() == "#define" ||
-                token->get_type() == cxir_tokens::CXX_PP_DEFINE) ||
-               (token->get_value() == "#ifdef" || token->get_type() == cxir_tokens::CXX_PP_IFDEF) ||
-               (token->get_value() == "#ifndef" ||
-                token->get_type() == cxir_tokens::CXX_PP_IFNDEF) ||
-               (token->get_value() == "#pragma" ||
-                token->get_type() == cxir_tokens::CXX_PP_PRAGMA) ||
-               (token->get_value() == "#undef" || token->get_type() == cxir_tokens::CXX_PP_UNDEF) ||
-               (token->get_value() == "#error" || token->get_type() == cxir_tokens::CXX_PP_ERROR) ||
-               (token->get_value() == "#warning" ||
-                token->get_type() == cxir_tokens::CXX_PP_WARNING) ||
-               (token->get_value() == "#line" || token->get_type() == cxir_tokens::CXX_PP_LINE);
-    }
+        // get the file names, each distinct file is only looked at once
+        for (const auto &token : tokens) {
+            if (token.get_line() == 0) {
+                continue;
+            }
 
-    bool is_1_token_pp_directive(const std::unique_ptr<CX_Token> &token) {
-        return (token->get_value() == "#endif" || token->get_type() == cxir_tokens::CXX_PP_ENDIF) ||
-               (token->get_value() == "#else" || token->get_type() == cxir_tokens::CXX_PP_ELSE);
-    }
+            if (token.file >= macro_of.size()) {
+                macro_of.resize(token.file + 1, nullptr);
+                map_file.resize(token.file + 1, 0);
+            }
 
-    std::string CXIR::generate_CXIR() const {
-        /// goals:
-        /// 1. we have to genrate the first #line directive to point to the original file and line 1
-        /// 2. everey CXIR token has to be separated by a newline (as to keep track of the excat
-        /// position in the original file)
-        ///    - this is important for the source map generation later on
-        /// 3. some CXIR tokens may not have any location information, in this case we have to look
-        /// ahead and behind to find the closest token with location information
-        ///    - in the case the diffrerence on LL and LR is the same, we choose LR (right) since it
-        ///    is more likely to be the correct one UNLESS theres a semicolon in between current and
-        ///    LR, in this case we choose LL
-
-        size_t      line_num = 1;
-        std::string file_name;
-
-        std::map<string, string> file_macros;
-        std::string              cxir;
-
-        // get the first file name
-        for (const auto &token : tokens) {
-            file_name = ::generator::CXIR::get_file_name(token);
+            if (std::ranges::find(files, token.file) == files.end()) {
+                files.push_back(token.file);
+            }
+        }
+
+        for (u32 file : files) {
+            const std::string &file_name = CX_Token::file_at(file);
 
-            if (file_name.empty() || file_macros.find(file_name) != file_macros.end()) {
+            if (normalize_file_name(file_name).empty()) {
                 continue;
             }
 
-            file_macros[file_name] = "__$FILE_" + std::to_string(f_index) + "__";
-            ++f_index;
+            auto [macro, inserted] = file_macros.try_emplace(file_name);
+
+            if (inserted) {  // numbered per unit, so its text never depends on what came before
+                macro->second = "__$FILE_" + std::to_string(file_macros.size() - 1) + "__";
+            }
+
+            macro_of[file] = &macro->second;
+
+            if (map != nullptr) {
+                map_file[file] = map->intern(file_name);
+            }
         }
 
+        auto macro_for = [&](const CX_Token &token) -> const std::string * {
+            return token.get_line() != 0 ? macro_of[token.file] : nullptr;
+        };
+
         for (const auto &file_macro : file_macros) {
-            cxir += "#define " + file_macro.second + " \"" + file_macro.first + "\"\n";
+            out << "#define " << file_macro.second << " \"" << file_macro.first << "\"\n";
         }
 
         // generate the first #line directive
@@ -139,195 +142,353 @@ __CXIR_CODEGEN_BEGIN {
 
         if (file_macros.empty()) [[unlikely]] {
             /// we have a big problem here
-            for (auto &tok : tokens) {
-                print("\"", tok->get_file_name(), "\"");
+            for (const auto &tok : tokens) {
+                print("\"", tok.get_file_name(), "\"");
             }
 
-            return "#error \"Lost the original file name\"";
+            out << "#error \"Lost the original file name\"";
+            return;
         }
 
-        cxir += "\n#line 1 " + file_macros.begin()->second + "\n";
+        size_t line       = 1;     // the line the c++ compiler takes the output line to be
+        bool   line_start = true;  // nothing has been written to the output line yet
+
+        auto end_line = [&]() {
+            if (!line_start) {
+                out << '\n';
+                ++line;
+                line_start = true;
+            }
+        };
+
+        auto set_line = [&](size_t to, const std::string *file) {
+            end_line();
+            out << "#line ";
+            out.write_number(to);
+
+            if (file != nullptr) {
+                out << ' ' << *file;
+            }
+
+            out << '\n';
+            line = to;
+        };
+
+        const std::string *file_macro = &file_macros.begin()->second;
+        out << '\n';
+        set_line(1, file_macro);
 
         for (size_t i = 0; i < tokens.size(); ++i) {
-            const auto &token = tokens[i];
-            const auto &_file_name = ::generator::CXIR::get_file_name(token);
-            const auto &_line_num = token->get_line();
+            if (!omit.empty() && i == omit.front().first) {  // another unit has the body
+                out << ';';
+                line_start = false;
 
-            if (!token || token->get_value().empty()) {
+                i    = omit.front().second - 1;
+                omit = omit.subspan(1);
                 continue;
             }
 
-            if (is_1_token_pp_directive(token)) {
-                cxir += "\n" + token->get_value() + "\n";
+            const auto        &token  = tokens[i];
+            const std::string *_macro = macro_for(token);
+            std::string_view   value  = value_of(token);
+
+            if (value.empty()) {
                 continue;
             }
 
-            if (is_2_token_pp_directive(token)) {
-                if ((i + 1) < tokens.size()) {
-                    cxir += "\n" + token->get_value() + " " + tokens[i + 1]->get_value() + "\n";
-                } else {
+            const Directive directive = directive_of(token);
+
+            if (directive == Directive::Single) {
+                end_line();
+                out << value << '\n';
+                ++line;
+                continue;
+            }
+
+            if (directive == Directive::Pair) {
+                if ((i + 1) >= tokens.size()) {
                     continue;
                 }
 
+                end_line();
+                out << value << ' ' << value_of(tokens[i + 1]) << '\n';
+                ++line;
+
                 ++i;  // skip the next token
                 continue;
             }
 
-            if ((token->get_value() == "#if" || token->get_type() == cxir_tokens::CXX_PP_IF) ||
-                (token->get_value() == "#elif" || token->get_type() == cxir_tokens::CXX_PP_ELIF)) {
-                // in this case we get the line from the next to next token since '#if (' - dont have a line number
-                ++line_num;
-                ++i; // skip #if or #elif
+            if (directive == Directive::Conditional) {
+                // '#if (' has no location, the condition is kept on the one line the directive
+                // takes up so the line count stays right
+                ++i;  // skip #if or #elif
 
                 // add all the tokens from the ( to the other ) keeping track of nesting
                 size_t nesting = 0;
-                size_t j       = i;
 
-                cxir += "\n#line " + std::to_string(line_num) + "\n";
-                cxir += "\n" + token->get_value() + " "; // add the #if or #elif
+                end_line();
+                out << value << ' ';  // add the #if or #elif
 
-                for (; j < tokens.size(); ++j) {
-                    if (tokens[j]->get_type() == cxir_tokens::CXX_LPAREN) {
+                for (size_t j = i; j < tokens.size(); ++j) {
+                    if (tokens[j].get_type() == cxir_tokens::CXX_LPAREN) {
                         ++nesting;
-                    } else if (tokens[j]->get_type() == cxir_tokens::CXX_RPAREN) {
+                    } else if (tokens[j].get_type() == cxir_tokens::CXX_RPAREN) {
                         --nesting;
                     }
 
+                    out << value_of(tokens[j]) << ' ';  // add the tokens in between and the last )
+
                     if (nesting == 0) {
                         i = j;
-
-                        cxir += tokens[j]->get_value() + " "; // add the last )
                         break;
                     }
+                }
+
+                out << '\n';
+                ++line;
+                continue;
+            }
+
+            if (_macro != nullptr && _macro != file_macro) {  // file change
+                file_macro = _macro;
+                set_line(token.get_line(), file_macro);
+            } else if (_macro != nullptr && token.get_line() != line) {
+                if (token.get_line() > line && token.get_line() - line <= MAX_LINE_GAP) {
+                    for (; line < token.get_line(); ++line) {
+                        out << '\n';
+                    }
 
-                    cxir += tokens[j]->get_value() + " "; // add the tokens in between
+                    line_start = true;
+                } else {
+                    set_line(token.get_line(), nullptr);
                 }
+            }
 
-                cxir += "\n";
-                cxir += "\n#line " + std::to_string(line_num) + "\n";
+            if (value[0] == '#') {
+                end_line();
+            }
 
-                continue;
+            if (map != nullptr && _macro != nullptr) {
+                map->add(out.position(),
+                         SourceLocation{.file   = map_file[token.file],
+                                        .line   = token.line,
+                                        .column = token.column,
+                                        .length = token.length});
+            }
+
+            out << value << ' ';
+            line_start = false;
 
+            if (!token.has_static_text()) {  // raw strings and inline c++ can span lines
+                line += static_cast<size_t>(std::ranges::count(value, '\n'));
             }
-            
-            if (!_file_name.empty() && _file_name != file_name) { // file change
-                file_name = _file_name;
-                cxir += "\n#line 1 " + file_macros[file_name] + "\n";
+        }
+
+        end_line();
+
+        // the next unit in the same translation unit numbers its files from 0 again
+        for (const auto &file_macro : file_macros) {
+            out << "#undef " << file_macro.second << '\n';
+        }
+    }
+
+    CXIR::Split CXIR::split(size_t parts) const {
+        const auto all = units();
+
+        struct Body {
+            size_t weight;
+            u32    unit;
+            u32    index;
+        };
+
+        std::vector<Body> work;
+
+        for (size_t unit = 0; unit < all.size(); ++unit) {
+            if (!all[unit]->splittable) {
+                return {};
             }
 
-            if (_line_num != 0 && _line_num != line_num) {
-                line_num = _line_num;
-                cxir += "\n#line " + std::to_string(line_num) + "\n";
+            for (size_t index = 0; index < all[unit]->bodies.size(); ++index) {
+                const auto &[begin, end] = all[unit]->bodies[index];
+                work.push_back({end - begin, static_cast<u32>(unit), static_cast<u32>(index)});
             }
+        }
+
+        parts = std::min(parts, work.size());
 
-            cxir += token->to_CXIR() + " ";
+        if (parts < 2) {
+            return {};
         }
 
-        return cxir;
+        // largest first, each to the part with the least so far. ties keep source order so the
+        // same program is always split the same way
+        std::ranges::stable_sort(work, std::ranges::greater{}, &Body::weight);
+
+        Split               result{.parts = parts, .owner = {}};
+        std::vector<size_t> load(parts, 0);
+
+        result.owner.resize(all.size());
+
+        for (size_t unit = 0; unit < all.size(); ++unit) {
+            result.owner[unit].resize(all[unit]->bodies.size(), 0);
+        }
+
+        for (const Body &body : work) {
+            const auto lightest =
+                static_cast<size_t>(std::ranges::min_element(load) - load.begin());
+
+            result.owner[body.unit][body.index] = static_cast<u32>(lightest);
+            load[lightest] += body.weight;
+        }
+
+        return result;
     }
 
+    void CXIR::write_part(CXIRWriter &out, const Split &split, u32 part, SourceMap *map) const {
+        const auto              all = units();
+        std::vector<TokenRange> omit;
+
+        out << get_core() << '\n';
+
+        for (size_t unit = 0; unit < all.size(); ++unit) {
+            omit.clear();
+
+            for (size_t index = 0; index < all[unit]->bodies.size(); ++index) {
+                if (split.owner[unit][index] != part) {
+                    omit.push_back(all[unit]->bodies[index]);
+                }
+            }
+
+            if (all[unit] == this) {
+                out << '\n';
+            }
+
+            all[unit]->write_CXIR(out, map, omit);
+        }
+    }
 }  // namespace __CXIR_CODEGEN_END
 
-// This logic is very flawed and needs to be re-written
-//     SourceLocation source_mapped_token = {.line   = token->get_line(),
-//                                           .column = token->get_column(),
-//                                           .length = token->get_length()};
-
-//     // find the nearest valid token
-//     if (token->get_line() == 0) {
-//         size_t LL = SIZE_MAX;  // left token index
-//         size_t LR = SIZE_MAX;  // left token index
-//         size_t NI = SIZE_MAX;  // nearest token index
-
-//         for (size_t j = i; j < tokens.size(); j++) {  // find the nearest token on the right
-//             if (tokens[j]->get_line() != 0) {
-//                 LR = j;
-//                 break;
-//             }
-//         }
-
-//         for (size_t j = i; j > 0; j--) {  // find the nearest token on the left
-//             if (tokens[j]->get_line() != 0) {
-//                 LL = j;
-//                 break;
-//             }
-//         }
-
-//         if (LL == SIZE_MAX && LR == SIZE_MAX) {
-//             source_mapped_token = {.line           = 0,
-//                                    .column         = 0,
-//                                    .length         = token->get_length(),
-//                                    .is_placeholder = true};
-
-//             goto APPEND_TOKEN_TO_CXIR;
-//         }
-
-//         if (LL == SIZE_MAX) {
-//             NI = LR;
-//         } else if (LR == SIZE_MAX) {
-//             NI = LL;
-//         } else {
-//             if (LR - i == i - LL) {
-//                 // if the difference is the same, we choose LR unless there is a semicolon
-//                 // in between current and LR
-
-//                 bool semicolon_found = false;
-
-//                 for (size_t j = i; j < LR; j++) {
-//                     if (tokens[j]->get_value() == ";" ||
-//                         tokens[j]->get_type() == cxir_tokens::CXX_SEMICOLON) {
-//                         semicolon_found = true;
-//                         break;
-//                     }
-//                 }
-
-//                 if (semicolon_found) {
-//                     NI = LL;
-//                 } else {
-//                     NI = LR;
-//                 }
-//             } else if (LR - i < i - LL) {  // choose the nearest one
-//                 NI = LR;
-//             } else {
-//                 NI = LL;
-//             }
-//         }
-
-//         if (NI == SIZE_MAX) {
-//             source_mapped_token = {.line   = tokens[NI]->get_line(),
-//                                    .column = tokens[NI]->get_column(),
-//                                    .length = tokens[NI]->get_length()};
-//         } else {
-//             if (LR != SIZE_MAX && LR != 0) {
-//                 source_mapped_token = {.line   = tokens[LR]->get_line(),
-//                                        .column = tokens[LR]->get_column(),
-//                                        .length = tokens[LR]->get_length()};
-//             } else if (LL != SIZE_MAX && LL != 0) {
-//                 source_mapped_token = {.line   = tokens[LL]->get_line(),
-//                                        .column = tokens[LL]->get_column(),
-//                                        .length = tokens[LL]->get_length()};
-//             } else {
-//                 source_mapped_token = {.line   = 0,
-//                                        .column = 0,
-//                                        .length = token->get_length(),
-//                                        .is_placeholder = true};
-//             }
-//         }
-//     }
-
-// APPEND_TOKEN_TO_CXIR:
-//     handle_file_change(file_name, cxir, token, source_map, cxir_line, cxir_col);
-//     source_map.append(source_mapped_token, cxir_line, cxir_col);
-
-//     cxir += token->get_value() + " ";
-
-//     if (cxir_col > 1000) {  // fill upto 1000 columns (this is for more efficient source map
-//                             // generation)
-//         cxir_col = 1;
-
-//         cxir += "\n";
-//         ++cxir_line;
-//     } else {
-//         cxir_col += (token->get_length() != 1 ? token->get_length() :
-//         token->get_value().length()) + 1;
-//     }
\ No newline at end of file
+namespace {
+    constexpr std::string_view SOURCE_MAP_MAGIC   = "HXSM";
+    constexpr u8               SOURCE_MAP_VERSION = 1;
+
+    void put_varint(std::string &out, u64 value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+
+        out.push_back(static_cast<char>(value));
+    }
+
+    std::optional<u64> get_varint(std::string_view data, size_t &pos) {
+        u64 value = 0;
+
+        for (u32 shift = 0; pos < data.size() && shift < 64; shift += 7) {
+            auto byte = static_cast<u8>(data[pos++]);
+            value |= static_cast<u64>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    u64 zigzag(i64 value) { return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63); }
+    i64 unzigzag(u64 value) { return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1); }
+}  // namespace
+
+std::string generator::CXIR::SourceMap::serialize() const {
+    std::string out(SOURCE_MAP_MAGIC);
+    out.push_back(static_cast<char>(SOURCE_MAP_VERSION));
+
+    put_varint(out, files.size());
+
+    for (const auto &file_name : files) {
+        put_varint(out, file_name.size());
+        out += file_name;
+    }
+
+    put_varint(out, offsets.size());
+
+    u32 offset = 0;
+    u32 line   = 0;
+
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const SourceLocation &loc = locations[i];
+
+        put_varint(out, offsets[i] - offset);
+        put_varint(out, loc.file);
+        put_varint(out, zigzag(static_cast<i64>(loc.line) - static_cast<i64>(line)));
+        put_varint(out, loc.column);
+        put_varint(out, loc.length);
+
+        offset = offsets[i];
+        line   = loc.line;
+    }
+
+    return out;
+}
+
+std::optional<generator::CXIR::SourceMap>
+generator::CXIR::SourceMap::deserialize(std::string_view data) {
+    if (!data.starts_with(SOURCE_MAP_MAGIC) || data.size() <= SOURCE_MAP_MAGIC.size() ||
+        static_cast<u8>(data[SOURCE_MAP_MAGIC.size()]) != SOURCE_MAP_VERSION) {
+        return std::nullopt;
+    }
+
+    SourceMap map;
+    size_t    pos = SOURCE_MAP_MAGIC.size() + 1;
+
+    auto file_count = get_varint(data, pos);
+
+    if (!file_count.has_value()) {
+        return std::nullopt;
+    }
+
+    for (u64 i = 0; i < *file_count; ++i) {
+        auto size = get_varint(data, pos);
+
+        if (!size.has_value() || *size > data.size() - pos) {
+            return std::nullopt;
+        }
+
+        map.files.emplace_back(data.substr(pos, *size));
+        pos += *size;
+    }
+
+    auto count = get_varint(data, pos);
+
+    if (!count.has_value()) {
+        return std::nullopt;
+    }
+
+    u64 offset = 0;
+    i64 line   = 0;
+
+    for (u64 i = 0; i < *count; ++i) {
+        auto offset_delta = get_varint(data, pos);
+        auto file         = get_varint(data, pos);
+        auto line_delta   = get_varint(data, pos);
+        auto column       = get_varint(data, pos);
+        auto length       = get_varint(data, pos);
+
+        if (!length.has_value() || !column.has_value() || !line_delta.has_value() ||
+            !file.has_value() || !offset_delta.has_value() || *file >= map.files.size()) {
+            return std::nullopt;
+        }
+
+        offset += *offset_delta;
+        line += unzigzag(*line_delta);
+
+        map.offsets.push_back(static_cast<u32>(offset));
+        map.locations.push_back(SourceLocation{.file   = static_cast<u32>(*file),
+                                               .line   = static_cast<u32>(line),
+                                               .column = static_cast<u32>(*column),
+                                               .length = static_cast<u32>(*length)});
+    }
+
+    return map;
+}
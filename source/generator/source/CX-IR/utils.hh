@@ -18,7 +18,6 @@
 
 #include <algorithm>
 #include <cctype>
-#include <chrono>
 #include <concepts>
 #include <cstdio>
 #include <ctime>
@@ -26,7 +25,6 @@
 #include <limits>
 #include <memory>
 #include <optional>
-#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -56,22 +54,6 @@
 
 enum class OperatorType { UnaryPrefix, UnaryPostfix, Binary, Array, Call, None };
 
-inline std::string generate_unique_name() {
-    auto now    = std::chrono::system_clock::now();
-    auto epoch  = now.time_since_epoch();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(epoch).count();
-
-    std::random_device              rd;
-    std::mt19937                    gen(rd());
-    std::uniform_int_distribution<> dis(1000, 9999);
-    int                             randomComponent = dis(gen);
-
-    std::ostringstream uniqueName;
-    uniqueName << "$_" << millis << "_" << randomComponent;
-
-    return uniqueName.str();
-}
-
 inline std::pair<bool, bool>
 contains_self_static(const __AST_N::NodeT<__AST_NODE::FuncDecl> &func_decl) {
     std::pair<bool, bool>               found_self_static = {false, false};
@@ -715,13 +697,13 @@ inline void add_func_modifiers(__CXIR_CODEGEN_N::CXIR *self, __AST_N::Modifiers
     */
 
     if (modifiers.contains(__TOKEN_N::KEYWORD_INLINE)) {
-        self->append(std ::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-            __CXIR_CODEGEN_N::cxir_tokens::CXX_INLINE, modifiers.get(__TOKEN_N::KEYWORD_INLINE)));
+        self->append(
+            __CXIR_CODEGEN_N::cxir_tokens::CXX_INLINE, modifiers.get(__TOKEN_N::KEYWORD_INLINE));
     }
 
     if (modifiers.contains(__TOKEN_N::KEYWORD_STATIC)) {
-        self->append(std::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-            __CXIR_CODEGEN_N::cxir_tokens::CXX_STATIC, modifiers.get(__TOKEN_N::KEYWORD_STATIC)));
+        self->append(
+            __CXIR_CODEGEN_N::cxir_tokens::CXX_STATIC, modifiers.get(__TOKEN_N::KEYWORD_STATIC));
     }
 
     if (modifiers.contains(__TOKEN_N::KEYWORD_CONST) &&
@@ -740,22 +722,22 @@ inline void add_func_modifiers(__CXIR_CODEGEN_N::CXIR *self, __AST_N::Modifiers
         }
         
         if (right_order) {
-            self->append(std::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-                __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEVAL, modifiers.get(__TOKEN_N::KEYWORD_EVAL)));
+            self->append(
+                __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEVAL, modifiers.get(__TOKEN_N::KEYWORD_EVAL));
         } else {
-            self->append(std::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-                __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEXPR, modifiers.get(__TOKEN_N::KEYWORD_EVAL)));
+            self->append(
+                __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEXPR, modifiers.get(__TOKEN_N::KEYWORD_EVAL));
         }
     } else if (modifiers.contains(__TOKEN_N::KEYWORD_EVAL)) {
-        self->append(std::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-            __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEXPR, modifiers.get(__TOKEN_N::KEYWORD_EVAL)));
+        self->append(
+            __CXIR_CODEGEN_N::cxir_tokens::CXX_CONSTEXPR, modifiers.get(__TOKEN_N::KEYWORD_EVAL));
     }
 }
 
 inline void add_func_specifiers(__CXIR_CODEGEN_N::CXIR *self, __AST_N::Modifiers modifiers) {
     if (modifiers.contains(__TOKEN_N::KEYWORD_CONST)) {
-        self->append(std::make_unique<__CXIR_CODEGEN_N::CX_Token>(
-            __CXIR_CODEGEN_N::cxir_tokens::CXX_CONST, modifiers.get(__TOKEN_N::KEYWORD_CONST)));
+        self->append(
+            __CXIR_CODEGEN_N::cxir_tokens::CXX_CONST, modifiers.get(__TOKEN_N::KEYWORD_CONST));
     }
 }
 
@@ -769,60 +751,60 @@ class ModifyNestedFunctions {
         : emitter(emitter) {}
 
     bool operator()(const __AST_N::NodeT<> &elm) const {
-        emitter->append(std::make_unique<CX_Token>(CXX_SEMICOLON));
+        emitter->append(CXX_SEMICOLON);
 
         if (elm->getNodeType() == __AST_NODE::nodes::FuncDecl) {
             __AST_N::NodeT<__AST_NODE::FuncDecl> func_decl = __AST_N::as<__AST_NODE::FuncDecl>(elm);
 
             if (func_decl->name != nullptr) {
-                emitter->append(std::make_unique<CX_Token>(CXX_AUTO));
-                emitter->append(std::make_unique<CX_Token>(CXX_CORE_IDENTIFIER,
-                                                           func_decl->name->get_back_name().value(),
-                                                           func_decl->marker));
-                emitter->append(std::make_unique<CX_Token>(CXX_EQUAL));
+                emitter->append(CXX_AUTO);
+                emitter->append(CXX_CORE_IDENTIFIER,
+                                func_decl->name->get_back_name().value(),
+                                func_decl->marker);
+                emitter->append(CXX_EQUAL);
             }
 
-            emitter->append(std::make_unique<CX_Token>(CXX_LBRACKET));
-            emitter->append(std::make_unique<CX_Token>(CXX_RBRACKET));
+            emitter->append(CXX_LBRACKET);
+            emitter->append(CXX_RBRACKET);
 
             if (func_decl->generics) {
-                emitter->append(std::make_unique<CX_Token>(CXX_LESS));
+                emitter->append(CXX_LESS);
                 func_decl->generics->params->accept(*emitter);
-                emitter->append(std::make_unique<CX_Token>(CXX_GREATER));
+                emitter->append(CXX_GREATER);
             }
 
-            emitter->append(std::make_unique<CX_Token>(CXX_LPAREN));
+            emitter->append(CXX_LPAREN);
             if (!func_decl->params.empty()) {
                 if (func_decl->params[0] != nullptr) {
                     func_decl->params[0]->accept(*emitter);
                 };
                 for (size_t i = 1; i < func_decl->params.size(); ++i) {
-                    emitter->append(std::make_unique<CX_Token>(CXX_CORE_OPERATOR, ","));
+                    emitter->append(CXX_CORE_OPERATOR, ",");
                     ;
                     if (func_decl->params[i] != nullptr) {
                         func_decl->params[i]->accept(*emitter);
                     };
                 }
             };
-            emitter->append(std::make_unique<CX_Token>(CXX_RPAREN));
+            emitter->append(CXX_RPAREN);
 
-            emitter->append(std::make_unique<CX_Token>(CXX_PTR_ACC));
+            emitter->append(CXX_PTR_ACC);
 
             if (func_decl->returns) {
                 func_decl->returns->accept(*emitter);
             } else {
-                emitter->append(std::make_unique<CX_Token>(CXX_VOID, func_decl->marker));
+                emitter->append(CXX_VOID, func_decl->marker);
             }
 
             if (func_decl->generics) {
                 if (func_decl->generics->bounds) {
-                    emitter->append(std::make_unique<CX_Token>(CXX_REQUIRES));
+                    emitter->append(CXX_REQUIRES);
                     func_decl->generics->bounds->accept(*emitter);
                 }
             }
 
             func_decl->body->accept(*emitter);
-            emitter->append(std::make_unique<CX_Token>(CXX_SEMICOLON));
+            emitter->append(CXX_SEMICOLON);
             return true;
         }
 
@@ -841,7 +823,7 @@ class ModifyNestedFunctions {
         if (elm->getNodeType() == __AST_NODE::nodes::LetDecl) {
             __AST_N::NodeT<__AST_NODE::LetDecl> node = __AST_N::as<__AST_NODE::LetDecl>(elm);
             emitter->visit(*node, true);
-            emitter->append(std::make_unique<CX_Token>(CXX_SEMICOLON));
+            emitter->append(CXX_SEMICOLON);
 
             return true;
         }
@@ -893,111 +875,101 @@ inline void check_for_yield_and_panic(const __AST_N::NodeT<__AST_NODE::SuiteStat
 }
 
 inline void default_constructor(CXIR *self, const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
 
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_RPAREN);
 
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 inline void default_destructor(CXIR *self, const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_TILDE, name->name));
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
+
+    self->append(cxir_tokens::CXX_TILDE, name->name);
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_RPAREN);
+
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 inline void delete_copy_constructor(CXIR *self, const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
-
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_CONST, name->name));
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
+
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_CONST, name->name);
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_RPAREN);
+
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 inline void delete_copy_assignment(CXIR *self, const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
-
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_OPERATOR, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_CONST, name->name));
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
+
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_OPERATOR, name->name);
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_CONST, name->name);
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_RPAREN);
+
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 inline void default_move_constructor(CXIR                                        *self,
                                      const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
-
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_NOEXCEPT));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
+
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_RPAREN);
+    self->append(cxir_tokens::CXX_NOEXCEPT);
+
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 inline void default_move_assignment(CXIR *self, const __AST_N::NodeT<__AST_NODE::IdentExpr> &name) {
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_PUBLIC));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_COLON));
-
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_OPERATOR, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_LPAREN));
-    self->append(std::make_unique<CX_Token>(
-        cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_AMPERSAND, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_RPAREN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_NOEXCEPT));
-
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_ASSIGN));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_DEFAULT, name->name));
-    self->append(std::make_unique<CX_Token>(cxir_tokens::CXX_SEMICOLON));
+    self->append(cxir_tokens::CXX_PUBLIC);
+    self->append(cxir_tokens::CXX_COLON);
+
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_OPERATOR, name->name);
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_LPAREN);
+    self->append(cxir_tokens::CXX_CORE_IDENTIFIER, name->name.value(), name->name);
+    self->append(cxir_tokens::CXX_AMPERSAND, name->name);
+    self->append(cxir_tokens::CXX_RPAREN);
+    self->append(cxir_tokens::CXX_NOEXCEPT);
+
+    self->append(cxir_tokens::CXX_ASSIGN);
+    self->append(cxir_tokens::CXX_DEFAULT, name->name);
+    self->append(cxir_tokens::CXX_SEMICOLON);
 }
 
 class Validator {
@@ -417,7 +417,7 @@ __AST_NODE_BEGIN {
         NodeV<CatchState>   catch_states;
         NodeT<FinallyState> finally_state;
 
-        bool no_catch;
+        bool no_catch = false;
     };
 
     class PanicState final : public Node {
@@ -0,0 +1,121 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+///                                                                                              ///
+///  constant folding, run over the ast right before it is lowered to cx-ir. literal only        ///
+///  expressions are evaluated with the same types the cx-ir literal inference would give them   ///
+///  (i32/i64, f32, bool and plain strings) and the expression is replaced by a single literal.  ///
+///  `const` and `eval` bindings with a literal value are propagated into later expressions in   ///
+///  the same scope, ternaries with a constant condition collapse to the taken branch.           ///
+///                                                                                              ///
+///  binary expressions are parsed right leaning and emitted flat (the c++ compiler applies the  ///
+///  precedence), so a chain of binary expressions is always folded as a whole using c++         ///
+///  precedence and never one sub-tree at a time.                                                ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __AST_CONST_FOLD_VISIT_H__
+#define __AST_CONST_FOLD_VISIT_H__
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/types/AST_types.hh"
+#include "parser/ast/include/types/AST_visitor.hh"
+
+__AST_VISITOR_BEGIN {
+    /// the value of a folded expression, ints carry the width they would be emitted as
+    struct Constant {
+        enum class Kind : u8 { Int, Float, Bool, String };
+
+        Kind        kind    = Kind::Int;
+        u8          width   = 32;
+        i64         integer = 0;
+        float       real    = 0;
+        bool        boolean = false;
+        std::string string;  // contents without the quotes, escapes left as written
+    };
+
+    class ConstFold : public Visitor {
+      public:
+        ConstFold()                             = default;
+        ConstFold(const ConstFold &)            = delete;
+        ConstFold(ConstFold &&)                 = delete;
+        ConstFold &operator=(const ConstFold &) = delete;
+        ConstFold &operator=(ConstFold &&)      = delete;
+        ~ConstFold() override                   = default;
+
+        /// literal value of a (non format) literal, nullopt if it is not something we fold
+        static std::optional<Constant> literal_value(const __AST_NODE::LiteralExpr &literal);
+
+        GENERATE_VISIT_EXTENDS;
+
+      private:
+        struct Scope {
+            std::unordered_map<std::string, std::optional<Constant>> names;
+            bool opaque = false;  // class like bodies, outer bindings may be shadowed by members
+        };
+
+        /// visit an expression slot and replace it with a literal (or the taken ternary branch)
+        std::optional<Constant> fold(const __AST_N::NodeT<> &slot);
+
+        /// visit a node but keep it in place, typed slots can only ever hold their own node type
+        template <typename T>
+        void walk(const __AST_N::NodeT<T> &node) {
+            if (node != nullptr) {
+                node->accept(*this);
+            }
+
+            result.reset();
+            replacement.reset();
+        }
+
+        void walk(const __AST_N::NodeT<> &node) { fold(node); }
+
+        /// expression slots that must stay as written (names, lvalues, member access)
+        void keep(const __AST_N::NodeT<> &node) { walk<__AST_NODE::Node>(node); }
+
+        template <typename T>
+        void walk(const __AST_N::NodeV<T> &nodes) {
+            for (const auto &node : nodes) {
+                walk(node);
+            }
+        }
+
+        void                    fold_chain(const __AST_NODE::BinaryExpr &root);
+        std::optional<Constant> apply(const Constant         &lhs,
+                                      const __TOKEN_N::Token &op,
+                                      const Constant         &rhs);
+
+        void push_scope(bool opaque = false) { scopes.push_back({{}, opaque}); }
+        void pop_scope() { scopes.pop_back(); }
+        void bind(const std::string &name, std::optional<Constant> value = std::nullopt);
+        [[nodiscard]] std::optional<Constant> lookup(const std::string &name) const;
+
+        std::vector<Scope>      scopes;
+        std::optional<Constant> result;       // value of the expression just visited
+        __TOKEN_N::Token        at;           // where the literal for `result` is placed
+        __AST_N::NodeT<>        replacement;  // node to put in place of the one just visited
+        bool                    const_binding = false;  // the next VarDecl is const or eval
+        bool                    chain_operand = false;  // the next ternary is a chain operand
+    };
+}  // namespace __AST_VISITOR_BEGIN
+
+#endif  // __AST_CONST_FOLD_VISIT_H__
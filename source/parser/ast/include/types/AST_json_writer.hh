@@ -0,0 +1,85 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __AST_JSON_WRITER_H__
+#define __AST_JSON_WRITER_H__
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/config/AST_config.def"
+
+__AST_VISITOR_BEGIN {
+    enum class JsonFormat : u8 { JSON, BEVE };
+
+    /// streaming json/beve writer used by the Jsonify visitor, values are encoded straight into a
+    /// reusable buffer (via glaze) instead of building an intermediate tree. json output is flushed
+    /// to the sink whenever the buffer grows past `flush_threshold`, beve output is flushed once
+    /// the outermost container is closed since container counts are patched in place.
+    class JsonWriter {
+      public:
+        static constexpr size_t flush_threshold = 64 * 1024;
+
+        explicit JsonWriter(JsonFormat format = JsonFormat::JSON, std::FILE *sink = stdout);
+        JsonWriter(const JsonWriter &)            = delete;
+        JsonWriter(JsonWriter &&)                 = delete;
+        JsonWriter &operator=(const JsonWriter &) = delete;
+        JsonWriter &operator=(JsonWriter &&)      = delete;
+        ~JsonWriter();
+
+        void begin_object();
+        void end_object();
+        void begin_array();
+        void end_array();
+
+        void key(std::string_view key);
+        void value(std::string_view val);
+        void value(const char *val) { value(std::string_view(val)); }
+        void value(i64 val);
+        void value(bool val);
+        void value(std::nullptr_t);
+
+        /// write everything that is final to the sink, called automatically by `end_*`
+        void flush();
+
+        /// take the encoded bytes instead of writing them out (only valid with a null sink)
+        std::string take();
+
+        [[nodiscard]] JsonFormat format() const { return fmt; }
+
+      private:
+        struct Frame {
+            size_t count_at;  // offset of the beve count placeholder
+            u32    count;
+            bool   is_object;
+        };
+
+        void element();
+        void close(bool is_object);
+        void maybe_flush();
+
+        JsonFormat         fmt;
+        std::FILE         *sink;
+        std::string        buf;
+        size_t             ix = 0;
+        std::vector<Frame> stack;
+    };
+}  // namespace __AST_VISITOR_BEGIN
+
+#endif  // __AST_JSON_WRITER_H__
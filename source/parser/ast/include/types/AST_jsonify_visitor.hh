@@ -16,37 +16,149 @@
 #ifndef __AST_JSONIFY_VISIT_H__
 #define __AST_JSONIFY_VISIT_H__
 
-#include "neo-json/include/json.hh"
+#include <concepts>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
 #include "parser/ast/include/config/AST_config.def"
 #include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/types/AST_json_writer.hh"
+#include "parser/ast/include/types/AST_modifiers.hh"
 #include "parser/ast/include/types/AST_types.hh"
 #include "parser/ast/include/types/AST_visitor.hh"
 
 __AST_VISITOR_BEGIN {
+    /// writes the ast straight into a JsonWriter as it is visited, each visit emits exactly one
+    /// value of the form {"NodeName": {...}} so children are written in place by recursing.
     class Jsonify : public Visitor {
       public:
-        Jsonify()                           = default;
-        Jsonify(const Jsonify &)            = default;
+        explicit Jsonify(JsonWriter &json)
+            : json(json) {}
+        Jsonify(const Jsonify &)            = delete;
         Jsonify(Jsonify &&)                 = delete;
-        Jsonify &operator=(const Jsonify &) = default;
+        Jsonify &operator=(const Jsonify &) = delete;
         Jsonify &operator=(Jsonify &&)      = delete;
         ~Jsonify() override                 = default;
 
-        neo::json json{"ast"};
+        JsonWriter &json;
 
-        GENERATE_VISIT_EXTENDS;
-    };
+        /// open {"name": { ... }} and close it again when the full-expression ends, so
+        /// `section("X").add(...).add(...)` streams the fields in order.
+        class Section {
+          public:
+            Section(Jsonify &visitor, std::string_view name)
+                : visitor(visitor) {
+                visitor.json.begin_object();
+                visitor.json.key(name);
+                visitor.json.begin_object();
+            }
+
+            Section(const Section &)            = delete;
+            Section(Section &&)                 = delete;
+            Section &operator=(const Section &) = delete;
+            Section &operator=(Section &&)      = delete;
+
+            ~Section() {
+                visitor.json.end_object();
+                visitor.json.end_object();
+            }
+
+            template <typename T>
+            Section &add(std::string_view key, const T &val) {
+                visitor.json.key(key);
+                visitor.emit(val);
+                return *this;
+            }
+
+          private:
+            Jsonify &visitor;
+        };
+
+        Section section(std::string_view name) { return {*this, name}; }
+
+        template <typename T>
+        void section(std::string_view name, const T &val) {
+            json.begin_object();
+            json.key(name);
+            emit(val);
+            json.end_object();
+        }
+
+        template <typename T>
+        void emit(const T &val) {
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                          std::is_convertible_v<T, const char *>) {
+                json.value(std::string_view(val));
+            } else if constexpr (std::is_same_v<T, bool>) {
+                json.value(val);
+            } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+                json.value(static_cast<i64>(val));
+            } else if constexpr (std::is_same_v<T, __TOKEN_N::Token>) {
+                emit_token(val);
+            } else if constexpr (requires { val->accept(*this); }) {
+                if (val == nullptr) {
+                    json.value(nullptr);
+                    return;
+                }
+
+                val->accept(*this);
+            } else if constexpr (std::is_same_v<T, __AST_N::Modifiers>) {
+                json.begin_object();
+                json.key("modifiers");
+                json.begin_array();
+
+                for (const auto &modifier : val.modifiers) {
+                    std::visit([this](const auto &spec) { emit(spec); }, modifier);
+                }
+
+                json.end_array();
+                json.end_object();
+            } else if constexpr (requires { val.marker; val.type; }) {
+                json.begin_object();
+                json.key("marker");
+                emit_token(val.marker);
+                json.key("type");
+                json.value(static_cast<i64>(val.type));
+                json.end_object();
+            } else {
+                json.begin_array();
 
-    inline neo::json get_node_json(const NodeT<> &node) {
-        auto visitor = Jsonify();
+                for (const auto &item : val) {
+                    emit(item);
+                }
 
-        if (node == nullptr) {
-            return neo::json("nullptr");
+                json.end_array();
+            }
         }
 
-        node->accept(visitor);
-        return visitor.json;
-    }
+        void emit_token(const __TOKEN_N::Token &tok) {
+            json.begin_object();
+            json.key("kind");
+            json.value(tok.token_kind_repr());
+            json.key("length");
+            json.value(static_cast<i64>(tok.length()));
+            json.key("loc");
+            json.begin_object();
+            json.key("column_number");
+            json.value(static_cast<i64>(tok.column_number()));
+            json.key("filename");
+            json.value(tok.file_name());
+            json.key("line_number");
+            json.value(static_cast<i64>(tok.line_number()));
+            json.key("offset");
+            json.value(static_cast<i64>(tok.offset()));
+            json.end_object();
+            json.key("value");
+            json.value(tok.value());
+            json.end_object();
+        }
+
+        GENERATE_VISIT_EXTENDS;
+    };
 }  // namespace __AST_BEGIN
 
 #endif  // __AST_JSONIFY_VISIT_H__
\ No newline at end of file
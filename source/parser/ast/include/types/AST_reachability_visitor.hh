@@ -0,0 +1,86 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+///                                                                                              ///
+///  reachability over the declarations of an imported module. every declaration is keyed by     ///
+///  the names it introduces and carries the names it mentions, starting from the names the      ///
+///  importing unit mentions the pass keeps whatever is (transitively) referenced and drops the  ///
+///  rest from the tree before it is lowered to cx-ir.                                           ///
+///                                                                                              ///
+///  names are matched by spelling only, so the pass over-approximates: every overload, every    ///
+///  member with the same name and every module sharing a name are kept together. declarations  ///
+///  that introduce no name (ffi blocks, top level statements, free operators) are always kept.  ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __AST_REACHABILITY_VISIT_H__
+#define __AST_REACHABILITY_VISIT_H__
+
+#include <string>
+#include <unordered_set>
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/types/AST_types.hh"
+#include "parser/ast/include/types/AST_visitor.hh"
+
+__AST_VISITOR_BEGIN {
+    using NameSet = std::unordered_set<std::string>;
+
+    /// collects every identifier a sub-tree mentions, including the words inside the strings
+    /// passed to `__inline_cpp` since those are pasted into the cx-ir verbatim
+    class References : public Visitor {
+      public:
+        References()                              = default;
+        References(const References &)            = delete;
+        References(References &&)                 = delete;
+        References &operator=(const References &) = delete;
+        References &operator=(References &&)      = delete;
+        ~References() override                    = default;
+
+        NameSet names;
+
+        GENERATE_VISIT_EXTENDS;
+
+      private:
+        template <typename T>
+        void walk(const __AST_N::NodeT<T> &node) {
+            if (node != nullptr) {
+                node->accept(*this);
+            }
+        }
+
+        template <typename T>
+        void walk(const __AST_N::NodeV<T> &nodes) {
+            for (const auto &node : nodes) {
+                walk(node);
+            }
+        }
+
+        void add(const __TOKEN_N::Token &name) { names.insert(name.value()); }
+
+        bool inline_cpp = false;  // the literals being visited are __inline_cpp arguments
+    };
+
+    /// \returns every name mentioned anywhere in `program`
+    NameSet references(const __AST_NODE::Program &program);
+
+    /// drop the top level (and module level) declarations of `program` that are not reachable
+    /// from `roots`
+    /// \returns `roots` together with every name the kept declarations mention, which is the
+    ///          root set for the modules `program` itself imports
+    NameSet prune_unreachable(__AST_NODE::Program &program, const NameSet &roots);
+}  // namespace __AST_VISITOR_BEGIN
+
+#endif  // __AST_REACHABILITY_VISIT_H__
@@ -0,0 +1,168 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+///                                                                                              ///
+///  binary snapshots of a parsed Program. the file is a header followed by flat tables:         ///
+///                                                                                              ///
+///     header | nodes | slots | tokens | string offsets | strings | dependencies | imports      ///
+///                                                                                              ///
+///  a node is its kind and a range of u32 slots holding its fields in declaration order. child  ///
+///  nodes are node indices, tokens and strings are indices into their tables, so the file does  ///
+///  not care where it is mapped. node 0 is the Program. the encoding is native endian, the      ///
+///  snapshots are a cache of the machine that wrote them.                                       ///
+///                                                                                              ///
+///  dependencies are the files the program was parsed from with a hash of their contents, and   ///
+///  imports the modules it imported. both are recorded for the driver, the format only keeps   ///
+///  them.                                                                                       ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#ifndef __AST_SNAPSHOT_H__
+#define __AST_SNAPSHOT_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/types/AST_types.hh"
+#include "token/include/private/Token_list.hh"
+
+__AST_BEGIN {
+    class Snapshot {
+      public:
+        static constexpr u32 VERSION = 1;        // bump when the layout or any node changes
+        static constexpr u32 NONE    = ~u32(0);  // a null child
+
+        struct Dependency {
+            std::string path;
+            u64         hash = 0;
+        };
+
+        struct Import {
+            std::string path;
+            bool        prune = true;
+        };
+
+        /// \returns `program` laid out as a snapshot, empty if it holds a node that can not be
+        /// stored. `stamp` identifies the writer, the view hands it back as is
+        [[nodiscard]] static std::string write(const __AST_NODE::Program     &program,
+                                               u64                            stamp,
+                                               const std::vector<Dependency> &dependencies,
+                                               const std::vector<Import>     &imports);
+    };
+
+    /// reads a snapshot in place, nothing is copied out of the bytes until `load` is called. the
+    /// bytes must outlive the view
+    class SnapshotView {
+      public:
+        struct TokenRef {
+            __TOKEN_N::tokens kind;
+            u32               line;
+            u32               column;
+            u32               length;
+            u32               offset;
+            std::string_view  value;
+            std::string_view  file;
+        };
+
+        struct DependencyRef {
+            std::string_view path;
+            u64              hash;
+        };
+
+        struct ImportRef {
+            std::string_view path;
+            bool             prune;
+        };
+
+        /// checks the header and that every table and index in `bytes` is in range, nullopt for
+        /// data that is not a snapshot of this version
+        static std::optional<SnapshotView> open(std::span<const std::byte> bytes);
+
+        [[nodiscard]] u64 stamp() const { return header.stamp; }
+
+        [[nodiscard]] u32                  node_count() const { return header.node_count; }
+        [[nodiscard]] __AST_NODE::nodes    kind(u32 node) const;
+        [[nodiscard]] std::span<const u32> slots(u32 node) const;
+        [[nodiscard]] u32                  token_count() const { return header.token_count; }
+        [[nodiscard]] TokenRef             token(u32 index) const;
+        [[nodiscard]] u32                  string_count() const { return header.string_count; }
+        [[nodiscard]] std::string_view     string(u32 index) const;
+
+        [[nodiscard]] u32           dependency_count() const { return header.dependency_count; }
+        [[nodiscard]] DependencyRef dependency(u32 index) const;
+        [[nodiscard]] u32           import_count() const { return header.import_count; }
+        [[nodiscard]] ImportRef     import(u32 index) const;
+
+        /// rebuilds the Program as heap nodes for the passes that take one, `tokens` becomes its
+        /// source token list. nullptr if the node slots do not match the node kinds
+        [[nodiscard]] NodeT<__AST_NODE::Program> load(__TOKEN_N::TokenList &tokens) const;
+
+      private:
+        struct Header {
+            char magic[4];
+            u32  version;
+            u64  stamp;
+            u32  node_count;
+            u32  slot_count;
+            u32  token_count;
+            u32  string_count;
+            u32  string_bytes;
+            u32  dependency_count;
+            u32  import_count;
+            u32  reserved;
+        };
+
+        SnapshotView() = default;
+
+        Header      header{};
+        const u32  *nodes_table      = nullptr;  // kind, first slot, slot count
+        const u32  *slot_table       = nullptr;
+        const u32  *token_table      = nullptr;  // kind, line, column, length, offset, value, file
+        const u32  *string_table     = nullptr;  // string_count + 1 offsets into `strings`
+        const char *strings          = nullptr;
+        const u32  *dependency_table = nullptr;  // path, hash low, hash high
+        const u32  *import_table     = nullptr;  // path, prune
+
+        friend class Snapshot;
+    };
+
+    /// a snapshot file mapped read only, read into memory where it can not be mapped
+    class SnapshotFile {
+      public:
+        explicit SnapshotFile(const std::filesystem::path &path);
+        SnapshotFile(const SnapshotFile &)            = delete;
+        SnapshotFile(SnapshotFile &&)                 = delete;
+        SnapshotFile &operator=(const SnapshotFile &) = delete;
+        SnapshotFile &operator=(SnapshotFile &&)      = delete;
+        ~SnapshotFile();
+
+        [[nodiscard]] std::optional<SnapshotView> view() const;
+
+      private:
+        const std::byte       *data = nullptr;
+        size_t                 size = 0;
+        std::vector<std::byte> fallback;  // the file when it is read instead of mapped
+        bool                   mapped = false;
+    };
+}  // namespace __AST_BEGIN
+
+#endif  // __AST_SNAPSHOT_H__
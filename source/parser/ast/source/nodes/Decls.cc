@@ -142,10 +142,10 @@ AST_NODE_IMPL(Declaration, RequiresParamDecl) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, RequiresParamDecl) {
-    json.section("RequiresParamDecl")
+    section("RequiresParamDecl")
         .add("is_const", node.is_const ? "true" : "false")
-        .add("var", get_node_json(node.var))
-        .add("value", get_node_json(node.value));
+        .add("var", node.var)
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -176,13 +176,7 @@ AST_NODE_IMPL(Declaration, RequiresParamList) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, RequiresParamList) {
-    std::vector<neo::json> params;
-
-    for (const auto &param : node.params) {
-        params.push_back(get_node_json(param));
-    }
-
-    json.section("RequiresParamList", params);
+    section("RequiresParamList", node.params);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -210,9 +204,9 @@ AST_NODE_IMPL(Declaration, EnumMemberDecl) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, EnumMemberDecl) {
-    json.section("EnumMemberDecl")
-        .add("name", get_node_json(node.name))
-        .add("value", get_node_json(node.value));
+    section("EnumMemberDecl")
+        .add("name", node.name)
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -255,14 +249,17 @@ AST_NODE_IMPL(Declaration, UDTDeriveDecl) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, UDTDeriveDecl) {
-    std::vector<neo::json> derives;
+    json.begin_object();
+    json.key("UDTDeriveDecl");
+    json.begin_array();
 
     for (const auto &derive : node.derives) {
-        derives.push_back(get_node_json(derive.first));
-        derives.push_back(derive.second.to_json());
+        emit(derive.first);
+        emit(derive.second);
     }
 
-    json.section("UDTDeriveDecl", derives);
+    json.end_array();
+    json.end_object();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -290,13 +287,7 @@ AST_NODE_IMPL(Declaration, TypeBoundList) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, TypeBoundList) {
-    std::vector<neo::json> bounds;
-
-    for (const auto &bound : node.bounds) {
-        bounds.push_back(get_node_json(bound));
-    }
-
-    json.section("TypeBoundList", bounds);
+    section("TypeBoundList", node.bounds);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -307,7 +298,7 @@ AST_NODE_IMPL(Declaration, TypeBoundDecl) {
     NOT_IMPLEMENTED;
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, TypeBoundDecl) { json.section("TypeBoundDecl"); }
+AST_NODE_IMPL_VISITOR(Jsonify, TypeBoundDecl) { section("TypeBoundDecl"); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -342,9 +333,9 @@ AST_NODE_IMPL(Declaration, RequiresDecl) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, RequiresDecl) {
-    json.section("RequiresDecl")
-        .add("params", get_node_json(node.params))
-        .add("bounds", get_node_json(node.bounds));
+    section("RequiresDecl")
+        .add("params", node.params)
+        .add("bounds", node.bounds);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -404,12 +395,12 @@ AST_NODE_IMPL(Declaration, StructDecl, const std::shared_ptr<__TOKEN_N::TokenLis
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, StructDecl) {
-    json.section("StructDecl")
-        .add("name", get_node_json(node.name))
-        .add("derives", get_node_json(node.derives))
-        .add("generics", get_node_json(node.generics))
-        .add("body", get_node_json(node.body))
-        .add("modifiers", node.modifiers.to_json());
+    section("StructDecl")
+        .add("name", node.name)
+        .add("derives", node.derives)
+        .add("generics", node.generics)
+        .add("body", node.body)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -425,7 +416,8 @@ AST_NODE_IMPL(Declaration,
     // ignore const modifer
     if (modifiers != nullptr) {
         for (auto &tok : *modifiers) {
-            if (!node->vis.find_add(tok.current().get())) {
+            if (!(node->vis.find_add(tok.current().get()) ||
+                  node->modifiers.find_add(tok.current().get()))) {
                 return std::unexpected(
                     PARSE_ERROR(tok.current().get(), "invalid modifier for const"));
             }
@@ -468,16 +460,10 @@ AST_NODE_IMPL(Declaration,
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ConstDecl) {
-    std::vector<neo::json> vars;
-
-    for (const auto &var : node.vars) {
-        vars.push_back(get_node_json(var));
-    }
-
-    json.section("ConstDecl")
-        .add("vars", vars)
-        .add("vis", node.vis.to_json())
-        .add("modifiers", node.modifiers.to_json());
+    section("ConstDecl")
+        .add("vars", node.vars)
+        .add("vis", node.vis)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -486,7 +472,7 @@ AST_NODE_IMPL(Declaration, ExtendDecl, const std::shared_ptr<__TOKEN_N::TokenLis
     NOT_IMPLEMENTED;
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, ExtendDecl) { json.section("ExtendDecl"); }
+AST_NODE_IMPL_VISITOR(Jsonify, ExtendDecl) { section("ExtendDecl"); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -582,12 +568,12 @@ AST_NODE_IMPL(Declaration, ClassDecl, const std::shared_ptr<__TOKEN_N::TokenList
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ClassDecl) {
-    json.section("ClassDecl")
-        .add("name", get_node_json(node.name))
-        .add("derives", get_node_json(node.derives))
-        .add("generics", get_node_json(node.generics))
-        .add("body", get_node_json(node.body))
-        .add("modifiers", node.modifiers.to_json());
+    section("ClassDecl")
+        .add("name", node.name)
+        .add("derives", node.derives)
+        .add("generics", node.generics)
+        .add("body", node.body)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -647,12 +633,12 @@ AST_NODE_IMPL(Declaration, InterDecl, const std::shared_ptr<__TOKEN_N::TokenList
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, InterDecl) {
-    json.section("InterDecl")
-        .add("name", get_node_json(node.name))
-        .add("derives", get_node_json(node.derives))
-        .add("generics", get_node_json(node.generics))
-        .add("body", get_node_json(node.body))
-        .add("modifiers", node.modifiers.to_json());
+    section("InterDecl")
+        .add("name", node.name)
+        .add("derives", node.derives)
+        .add("generics", node.generics)
+        .add("body", node.body)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -733,17 +719,11 @@ AST_NODE_IMPL(Declaration, EnumDecl, const std::shared_ptr<__TOKEN_N::TokenList>
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, EnumDecl) {
-    std::vector<neo::json> members;
-
-    for (const auto &member : node.members) {
-        members.push_back(get_node_json(member));
-    }
-
-    json.section("EnumDecl")
-        .add("derives", get_node_json(node.derives))
-        .add("members", members)
-        .add("vis", node.vis.to_json())
-        .add("name", get_node_json(node.name));
+    section("EnumDecl")
+        .add("derives", node.derives)
+        .add("members", node.members)
+        .add("vis", node.vis)
+        .add("name", node.name);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -799,11 +779,11 @@ AST_NODE_IMPL(Declaration, TypeDecl, const std::shared_ptr<__TOKEN_N::TokenList>
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, TypeDecl) {
-    json.section("TypeDecl")
-        .add("name", get_node_json(node.name))
-        .add("generics", get_node_json(node.generics))
-        .add("type", get_node_json(node.type))
-        .add("vis", node.vis.to_json());
+    section("TypeDecl")
+        .add("name", node.name)
+        .add("generics", node.generics)
+        .add("type", node.type)
+        .add("vis", node.vis);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -942,20 +922,14 @@ AST_NODE_IMPL(Declaration,
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, FuncDecl) {
-    std::vector<neo::json> params;
-
-    for (const auto &param : node.params) {
-        params.push_back(get_node_json(param));
-    }
-
-    json.section("FuncDecl")
-        .add("name", get_node_json(node.name))
-        .add("params", params)
-        .add("generics", get_node_json(node.generics))
-        .add("returns", get_node_json(node.returns))
-        .add("body", get_node_json(node.body))
-        .add("modifiers", node.modifiers.to_json())
-        .add("qualifiers", node.qualifiers.to_json());
+    section("FuncDecl")
+        .add("name", node.name)
+        .add("params", node.params)
+        .add("generics", node.generics)
+        .add("returns", node.returns)
+        .add("body", node.body)
+        .add("modifiers", node.modifiers)
+        .add("qualifiers", node.qualifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -986,9 +960,9 @@ AST_NODE_IMPL(Declaration, VarDecl, bool force_type, bool force_value) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, VarDecl) {
-    json.section("VarDecl")
-        .add("var", get_node_json(node.var))
-        .add("value", get_node_json(node.value));
+    section("VarDecl")
+        .add("var", node.var)
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1053,10 +1027,10 @@ AST_NODE_IMPL(Declaration, FFIDecl, const std::shared_ptr<__TOKEN_N::TokenList>
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, FFIDecl) {
-    json.section("FFIDecl")
-        .add("name", get_node_json(node.name))
-        .add("value", get_node_json(node.value))
-        .add("vis", node.vis.to_json());
+    section("FFIDecl")
+        .add("name", node.name)
+        .add("value", node.value)
+        .add("vis", node.vis);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1113,16 +1087,10 @@ AST_NODE_IMPL(Declaration, LetDecl, const std::shared_ptr<__TOKEN_N::TokenList>
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, LetDecl) {
-    std::vector<neo::json> vars;
-
-    for (const auto &var : node.vars) {
-        vars.push_back(get_node_json(var));
-    }
-
-    json.section("LetDecl")
-        .add("vars", vars)
-        .add("vis", node.vis.to_json())
-        .add("modifiers", node.modifiers.to_json());
+    section("LetDecl")
+        .add("vars", node.vars)
+        .add("vis", node.vis)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1166,10 +1134,10 @@ AST_NODE_IMPL(Declaration, OpDecl, const std::shared_ptr<__TOKEN_N::TokenList> &
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, OpDecl) {
-    json.section("OpDecl")
+    section("OpDecl")
         .add("op", node.op)
-        .add("func", get_node_json(node.func))
-        .add("modifiers", node.modifiers.to_json());
+        .add("func", node.func)
+        .add("modifiers", node.modifiers);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1206,9 +1174,9 @@ AST_NODE_IMPL(Declaration, ModuleDecl, const std::shared_ptr<__TOKEN_N::TokenLis
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ModuleDecl) {
-    json.section("ModuleDecl")
-        .add("name", get_node_json(node.name))
-        .add("body", get_node_json(node.body))
+    section("ModuleDecl")
+        .add("name", node.name)
+        .add("body", node.body)
         .add("inline_module", node.inline_module ? "true" : "false");
 }
 
@@ -592,17 +592,9 @@ AST_NODE_IMPL(Expression, LiteralExpr, ParseResult<> str_concat) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, LiteralExpr) {
-    std::vector<neo::json> args;
-
-    if (node.contains_format_args && !node.format_args.empty()) {
-        for (const auto &arg : node.format_args) {
-            args.push_back(get_node_json(arg));
-        }
-    }
-
-    json.section("LiteralExpr")
+    section("LiteralExpr")
         .add("value", node.value)
-        .add("format_args", args)
+        .add("format_args", node.format_args)
         .add("contains_format_args", ((node.contains_format_args) ? "true" : "false"))
         .add("type", (int)node.getNodeType());
 }
@@ -641,10 +633,10 @@ AST_NODE_IMPL(Expression, BinaryExpr, ParseResult<> lhs, int min_precedence) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, BinaryExpr) {
-    json.section("BinaryExpr")
-        .add("lhs", get_node_json(node.lhs))
+    section("BinaryExpr")
+        .add("lhs", node.lhs)
         .add("op", node.op)
-        .add("rhs", get_node_json(node.rhs));
+        .add("rhs", node.rhs);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -676,8 +668,8 @@ AST_NODE_IMPL(Expression, UnaryExpr, ParseResult<> lhs, bool in_type) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, UnaryExpr) {
-    json.section("UnaryExpr")
-        .add("operand", get_node_json(node.opd))
+    section("UnaryExpr")
+        .add("operand", node.opd)
         .add("op", node.op)
         .add("type", (int)node.type);
 }
@@ -701,7 +693,7 @@ AST_NODE_IMPL(Expression, IdentExpr) {
     return make_node<IdentExpr>(tok, is_reserved_primitive);
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, IdentExpr) { json.section("IdentExpr", node.name); }
+AST_NODE_IMPL_VISITOR(Jsonify, IdentExpr) { section("IdentExpr", node.name); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -730,9 +722,9 @@ AST_NODE_IMPL(Expression, NamedArgumentExpr, bool is_anonymous) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, NamedArgumentExpr) {
-    json.section("NamedArgumentExpr")
-        .add("name", get_node_json(node.name))
-        .add("value", get_node_json(node.value));
+    section("NamedArgumentExpr")
+        .add("name", node.name)
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -771,9 +763,9 @@ AST_NODE_IMPL(Expression, ArgumentExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ArgumentExpr) {
-    json.section("ArgumentExpr")
+    section("ArgumentExpr")
         .add("type", (int)node.type)
-        .add("value", get_node_json(node.value));
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -814,13 +806,7 @@ AST_NODE_IMPL(Expression, ArgumentListExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ArgumentListExpr) {
-    std::vector<neo::json> args;
-
-    for (const auto &arg : node.args) {
-        args.push_back(get_node_json(arg));
-    }
-
-    json.section("ArgumentListExpr", args);
+    section("ArgumentListExpr", node.args);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -885,13 +871,7 @@ AST_NODE_IMPL(Expression, GenericInvokeExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, GenericInvokeExpr) {
-    std::vector<neo::json> args;
-
-    for (const auto &arg : node.args) {
-        args.push_back(get_node_json(arg));
-    }
-
-    json.section("GenericInvokeExpr", args);
+    section("GenericInvokeExpr", node.args);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -985,15 +965,9 @@ LINE910_PARSE_SCOPE_PATH_EXPR:
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ScopePathExpr) {
-    std::vector<neo::json> path;
-
-    for (const auto &p : node.path) {
-        path.push_back(get_node_json(p));
-    }
-
-    json.section("ScopePathExpr")
-        .add("path", path)
-        .add("access", get_node_json(node.access))
+    section("ScopePathExpr")
+        .add("path", node.path)
+        .add("access", node.access)
         .add("global_scope", node.global_scope ? "true" : "false");
 }
 
@@ -1019,9 +993,9 @@ AST_NODE_IMPL(Expression, DotPathExpr, ParseResult<> lhs) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, DotPathExpr) {
-    json.section("DotPathExpr")
-        .add("lhs", get_node_json(node.lhs))
-        .add("rhs", get_node_json(node.rhs));
+    section("DotPathExpr")
+        .add("lhs", node.lhs)
+        .add("rhs", node.rhs);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1049,9 +1023,9 @@ AST_NODE_IMPL(Expression, ArrayAccessExpr, ParseResult<> lhs) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ArrayAccessExpr) {
-    json.section("ArrayAccessExpr")
-        .add("array", get_node_json(node.lhs))
-        .add("index", get_node_json(node.rhs));
+    section("ArrayAccessExpr")
+        .add("array", node.lhs)
+        .add("index", node.rhs);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1089,7 +1063,7 @@ AST_NODE_IMPL(Expression, PathExpr, ParseResult<> simple_path) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, PathExpr) {
-    json.section("PathExpr").add("path", get_node_json(node.path)).add("type", (int)node.type);
+    section("PathExpr").add("path", node.path).add("type", (int)node.type);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1139,10 +1113,10 @@ AST_NODE_IMPL(Expression,
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, FunctionCallExpr) {
-    json.section("FunctionCallExpr")
-        .add("path", get_node_json(node.path))
-        .add("args", get_node_json(node.args))
-        .add("generics", get_node_json(node.generic));
+    section("FunctionCallExpr")
+        .add("path", node.path)
+        .add("args", node.args)
+        .add("generics", node.generic);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1190,13 +1164,7 @@ AST_NODE_IMPL(Expression, ArrayLiteralExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ArrayLiteralExpr) {
-    std::vector<neo::json> values;
-
-    for (const auto &value : node.values) {
-        values.push_back(get_node_json(value));
-    }
-
-    json.section("ArrayLiteralExpr", values);
+    section("ArrayLiteralExpr", node.values);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1251,13 +1219,7 @@ AST_NODE_IMPL(Expression, TupleLiteralExpr, ParseResult<> starting_element) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, TupleLiteralExpr) {
-    std::vector<neo::json> values;
-
-    for (const auto &value : node.values) {
-        values.push_back(get_node_json(value));
-    }
-
-    json.section("TupleLiteralExpr", values);
+    section("TupleLiteralExpr", node.values);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1309,13 +1271,7 @@ AST_NODE_IMPL(Expression, SetLiteralExpr, ParseResult<> first) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, SetLiteralExpr) {
-    std::vector<neo::json> values;
-
-    for (const auto &value : node.values) {
-        values.push_back(get_node_json(value));
-    }
-
-    json.section("SetLiteralExpr", values);
+    section("SetLiteralExpr", node.values);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1337,9 +1293,9 @@ AST_NODE_IMPL(Expression, MapPairExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, MapPairExpr) {
-    json.section("MapPairExpr")
-        .add("key", get_node_json(node.key))
-        .add("value", get_node_json(node.value));
+    section("MapPairExpr")
+        .add("key", node.key)
+        .add("value", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1397,13 +1353,7 @@ AST_NODE_IMPL(Expression, MapLiteralExpr, ParseResult<> key) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, MapLiteralExpr) {
-    std::vector<neo::json> values;
-
-    for (const auto &value : node.values) {
-        values.push_back(get_node_json(value));
-    }
-
-    json.section("MapLiteralExpr", values);
+    section("MapLiteralExpr", node.values);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1465,13 +1415,7 @@ AST_NODE_IMPL(Expression, ObjInitExpr, bool skip_start_brace, ParseResult<> obj_
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ObjInitExpr) {
-    std::vector<neo::json> kwargs;
-
-    for (const auto &kwarg : node.kwargs) {
-        kwargs.push_back(get_node_json(kwarg));
-    }
-
-    json.section("ObjInitExpr").add("keyword_args", kwargs).add("path", get_node_json(node.path));
+    section("ObjInitExpr").add("keyword_args", node.kwargs).add("path", node.path);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1503,18 +1447,12 @@ AST_NODE_IMPL(Expression, LambdaExpr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, LambdaExpr) {
-    std::vector<neo::json> args;
-
-    for (const auto &arg : node.params) {
-        args.push_back(get_node_json(arg));
-    }
-
-    json.section("LambdaExpr")
+    section("LambdaExpr")
         .add("maker", node.marker)
-        .add("body", get_node_json(node.body))
-        .add("params", args)
-        .add("generics", get_node_json(node.generics))
-        .add("returns", get_node_json(node.returns));
+        .add("body", node.body)
+        .add("params", node.params)
+        .add("generics", node.generics)
+        .add("returns", node.returns);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1565,10 +1503,10 @@ AST_NODE_IMPL(Expression, TernaryExpr, ParseResult<> E1) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, TernaryExpr) {
-    json.section("TernaryExpr")
-        .add("condition", get_node_json(node.condition))
-        .add("if_true", get_node_json(node.if_true))
-        .add("if_false", get_node_json(node.if_false));
+    section("TernaryExpr")
+        .add("condition", node.condition)
+        .add("if_true", node.if_true)
+        .add("if_false", node.if_false);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1599,7 +1537,7 @@ AST_NODE_IMPL(Expression, ParenthesizedExpr, ParseResult<> expr) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ParenthesizedExpr) {
-    json.section("ParenthesizedExpr", get_node_json(node.value));
+    section("ParenthesizedExpr", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1624,9 +1562,9 @@ AST_NODE_IMPL(Expression, CastExpr, ParseResult<> lhs) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, CastExpr) {
-    json.section("CastExpr")
-        .add("value", get_node_json(node.value))
-        .add("type", get_node_json(node.type));
+    section("CastExpr")
+        .add("value", node.value)
+        .add("type", node.type);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1676,9 +1614,9 @@ AST_NODE_IMPL(Expression, InstOfExpr, ParseResult<> lhs, bool in_requires) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, InstOfExpr) {
-    json.section("InstOfExpr")
-        .add("value", get_node_json(node.value))
-        .add("type", get_node_json(node.type))
+    section("InstOfExpr")
+        .add("value", node.value)
+        .add("type", node.type)
         .add("op", (int)node.op);
 }
 
@@ -1928,10 +1866,10 @@ AST_NODE_IMPL(Expression, Type) {  // TODO - REMAKE using the new Modifiers and
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, Type) {
-    json.section("Type")
-        .add("value", get_node_json(node.value))
-        .add("generics", get_node_json(node.generics))
-        .add("specifiers", node.specifiers.to_json())
+    section("Type")
+        .add("value", node.value)
+        .add("generics", node.generics)
+        .add("specifiers", node.specifiers)
         .add("is_fn_ptr", node.is_fn_ptr ? "true" : "false")
         .add("nullable", node.nullable ? "true" : "false");
 }
@@ -1959,8 +1897,8 @@ AST_NODE_IMPL(Expression, AsyncThreading) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, AsyncThreading) {
-    json.section("AsyncThreading")
-        .add("value", get_node_json(node.value))
+    section("AsyncThreading")
+        .add("value", node.value)
         .add("type", (int)node.type);
 }
 
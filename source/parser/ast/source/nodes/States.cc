@@ -399,9 +399,9 @@ AST_NODE_IMPL(Statement, NamedVarSpecifier, bool force_type) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, NamedVarSpecifier) {
-    json.section("NamedVarSpecifier")
-        .add("path", get_node_json(node.path))
-        .add("type", get_node_json(node.type));
+    section("NamedVarSpecifier")
+        .add("path", node.path)
+        .add("type", node.type);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -438,13 +438,7 @@ AST_NODE_IMPL(Statement, NamedVarSpecifierList, bool force_type) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, NamedVarSpecifierList) {
-    std::vector<neo::json> vars;
-
-    for (const auto &var : node.vars) {
-        vars.push_back(get_node_json(var));
-    }
-
-    json.section("NamedVarSpecifierList", vars);
+    section("NamedVarSpecifierList", node.vars);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -522,11 +516,11 @@ AST_NODE_IMPL(Statement, ForPyStatementCore, bool skip_start) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ForPyStatementCore) {
-    json.section("ForPyStatementCore")
-        .add("range", get_node_json(node.range))
-        .add("body", get_node_json(node.body))
+    section("ForPyStatementCore")
+        .add("range", node.range)
+        .add("body", node.body)
         .add("in_marker", node.in_marker)
-        .add("vars", get_node_json(node.vars));
+        .add("vars", node.vars);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -606,11 +600,11 @@ AST_NODE_IMPL(Statement, ForCStatementCore, bool skip_start) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ForCStatementCore) {
-    json.section("ForCStatementCore")
-        .add("init", get_node_json(node.init))
-        .add("condition", get_node_json(node.condition))
-        .add("update", get_node_json(node.update))
-        .add("body", get_node_json(node.body));
+    section("ForCStatementCore")
+        .add("init", node.init)
+        .add("condition", node.condition)
+        .add("update", node.update)
+        .add("body", node.body);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -665,7 +659,7 @@ AST_NODE_IMPL(Statement, ForState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ForState) {
-    json.section("ForState").add("core", get_node_json(node.core)).add("type", (int)node.type);
+    section("ForState").add("core", node.core).add("type", (int)node.type);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -687,9 +681,9 @@ AST_NODE_IMPL(Statement, WhileState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, WhileState) {
-    json.section("WhileState")
-        .add("condition", get_node_json(node.condition))
-        .add("body", get_node_json(node.body));
+    section("WhileState")
+        .add("condition", node.condition)
+        .add("body", node.body);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -725,9 +719,9 @@ AST_NODE_IMPL(Statement, ElseState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ElseState) {
-    json.section("ElseState")
-        .add("condition", get_node_json(node.condition))
-        .add("body", get_node_json(node.body))
+    section("ElseState")
+        .add("condition", node.condition)
+        .add("body", node.body)
         .add("type", (int)node.type);
 }
 
@@ -803,16 +797,10 @@ AST_NODE_IMPL(Statement, IfState, bool has_const, bool has_eval) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, IfState) {
-    std::vector<neo::json> else_body;
-
-    for (const auto &else_state : node.else_body) {
-        else_body.push_back(get_node_json(else_state));
-    }
-
-    json.section("IfState")
-        .add("condition", get_node_json(node.condition))
-        .add("body", get_node_json(node.body))
-        .add("else_body", else_body)
+    section("IfState")
+        .add("condition", node.condition)
+        .add("body", node.body)
+        .add("else_body", node.else_body)
         .add("type", (int)node.type);
 }
 
@@ -881,9 +869,9 @@ AST_NODE_IMPL(Statement, SwitchCaseState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, SwitchCaseState) {
-    json.section("SwitchCaseState")
-        .add("condition", get_node_json(node.condition))
-        .add("body", get_node_json(node.body))
+    section("SwitchCaseState")
+        .add("condition", node.condition)
+        .add("body", node.body)
         .add("type", (int)node.type)
         .add("marker", node.marker);
 }
@@ -951,13 +939,7 @@ AST_NODE_IMPL(Statement, SwitchState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, SwitchState) {
-    std::vector<neo::json> cases;
-
-    for (const auto &case_state : node.cases) {
-        cases.push_back(get_node_json(case_state));
-    }
-
-    json.section("SwitchState").add("condition", get_node_json(node.condition)).add("cases", cases);
+    section("SwitchState").add("condition", node.condition).add("cases", node.cases);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -983,7 +965,7 @@ AST_NODE_IMPL(Statement, YieldState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, YieldState) {
-    json.section("YieldState", get_node_json(node.value));
+    section("YieldState", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1004,7 +986,7 @@ AST_NODE_IMPL(Statement, DeleteState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, DeleteState) {
-    json.section("DeleteState", get_node_json(node.value));
+    section("DeleteState", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1076,8 +1058,8 @@ AST_NODE_IMPL(Statement, ImportState, bool is_ffi) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ImportState) {
-    json.section("ImportState")
-        .add("import", get_node_json(node.import))
+    section("ImportState")
+        .add("import", node.import)
         .add("type", (int)node.type);
 }
 
@@ -1132,15 +1114,7 @@ AST_NODE_IMPL(Statement, ImportItems) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ImportItems) {
-    json.section("ImportItems");
-
-    std::vector<neo::json> imports;
-
-    for (const auto &import : node.imports) {
-        imports.push_back(get_node_json(import));
-    }
-
-    json.add("imports", imports);
+    section("ImportItems").add("imports", node.imports);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1265,9 +1239,9 @@ AST_NODE_IMPL(Statement, SingleImport) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, SingleImport) {
-    json.section("SingleImport")
-        .add("path", get_node_json(node.path))
-        .add("alias", get_node_json(node.alias))
+    section("SingleImport")
+        .add("path", node.path)
+        .add("alias", node.alias)
         .add("is_wildcard", node.is_wildcard ? "true" : "false")
         .add("type", (int)node.type);
 }
@@ -1326,9 +1300,9 @@ AST_NODE_IMPL(Statement, SpecImport, ParseResult<SingleImport> path) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, SpecImport) {
-    json.section("SpecImport")
-        .add("path", get_node_json(node.path))
-        .add("imports", get_node_json(node.imports))
+    section("SpecImport")
+        .add("path", node.path)
+        .add("imports", node.imports)
         .add("type", (int)node.type);
 }
 
@@ -1336,7 +1310,7 @@ AST_NODE_IMPL_VISITOR(Jsonify, SpecImport) {
 
 AST_NODE_IMPL(Statement, MultiImportState) { NOT_IMPLEMENTED; }
 
-AST_NODE_IMPL_VISITOR(Jsonify, MultiImportState) { json.section("MultiImportState"); }
+AST_NODE_IMPL_VISITOR(Jsonify, MultiImportState) { section("MultiImportState"); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -1356,7 +1330,7 @@ AST_NODE_IMPL(Statement, ReturnState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ReturnState) {
-    json.section("ReturnState", get_node_json(node.value));
+    section("ReturnState", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1375,7 +1349,7 @@ AST_NODE_IMPL(Statement, BreakState) {
     return node;
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, BreakState) { json.section("BreakState", node.marker); }
+AST_NODE_IMPL_VISITOR(Jsonify, BreakState) { section("BreakState", node.marker); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -1393,7 +1367,7 @@ AST_NODE_IMPL(Statement, ContinueState) {
     return node;
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, ContinueState) { json.section("ContinueState", node.marker); }
+AST_NODE_IMPL_VISITOR(Jsonify, ContinueState) { section("ContinueState", node.marker); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -1410,7 +1384,7 @@ AST_NODE_IMPL(Statement, ExprState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ExprState) {
-    json.section("ExprState").add("expr", get_node_json(node.value));
+    section("ExprState").add("expr", node.value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1445,7 +1419,7 @@ AST_NODE_IMPL(Statement, SuiteState) {
                         CURRENT_TOK.token_kind_repr()));
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, SuiteState) { json.section("SuiteState", get_node_json(node.body)); }
+AST_NODE_IMPL_VISITOR(Jsonify, SuiteState) { section("SuiteState", node.body); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -1480,13 +1454,7 @@ AST_NODE_IMPL(Statement, BlockState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, BlockState) {
-    std::vector<neo::json> body_json;
-
-    for (const auto &node : node.body) {
-        body_json.push_back(get_node_json(node));
-    }
-
-    json.section("BlockState", body_json);
+    section("BlockState", node.body);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1542,16 +1510,10 @@ AST_NODE_IMPL(Statement, TryState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, TryState) {
-    std::vector<neo::json> catch_states;
-
-    for (const auto &catch_state : node.catch_states) {
-        catch_states.push_back(get_node_json(catch_state));
-    }
-
-    json.section("TryState")
-        .add("body", get_node_json(node.body))
-        .add("catches", catch_states)
-        .add("finally", get_node_json(node.finally_state))
+    section("TryState")
+        .add("body", node.body)
+        .add("catches", node.catch_states)
+        .add("finally", node.finally_state)
         .add("no_catch", (int)node.no_catch);
 }
 
@@ -1607,9 +1569,9 @@ AST_NODE_IMPL(Statement, CatchState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, CatchState) {
-    json.section("CatchState")
-        .add("catch", get_node_json(node.catch_state))
-        .add("body", get_node_json(node.body));
+    section("CatchState")
+        .add("catch", node.catch_state)
+        .add("body", node.body);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -1633,7 +1595,7 @@ AST_NODE_IMPL(Statement, PanicState) {
     return make_node<PanicState>(expr.value(), marker);
 }
 
-AST_NODE_IMPL_VISITOR(Jsonify, PanicState) { json.section("PanicState", get_node_json(node.expr)); }
+AST_NODE_IMPL_VISITOR(Jsonify, PanicState) { section("PanicState", node.expr); }
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -1652,7 +1614,7 @@ AST_NODE_IMPL(Statement, FinallyState) {
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, FinallyState) {
-    json.section("FinallyState", get_node_json(node.body));
+    section("FinallyState", node.body);
 }
 
 // ---------------------------------------------------------------------------------------------- //
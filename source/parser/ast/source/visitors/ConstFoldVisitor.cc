@@ -0,0 +1,1172 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <neo-panic/include/error.hh>
+#include <string>
+#include <string_view>
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/private/base/AST_base.hh"
+#include "parser/ast/include/types/AST_const_fold_visitor.hh"
+
+namespace {
+using Constant = __AST_VISITOR::Constant;
+
+std::optional<u8> int_width(i64 value) {
+    // mirrors the literal inference in cx-ir: anything up to u32 is emitted as an i32 (so values
+    // past i32 max would wrap), anything up to u64 as an i64
+    if (value >= std::numeric_limits<i32>::min() && value <= std::numeric_limits<i32>::max()) {
+        return 32;
+    }
+
+    if (value > std::numeric_limits<i32>::max() && value <= std::numeric_limits<u32>::max()) {
+        return std::nullopt;
+    }
+
+    return 64;
+}
+
+std::optional<i64> parse_int(std::string_view text) {
+    bool negative = false;
+
+    if (text.starts_with('-')) {
+        negative = true;
+        text.remove_prefix(1);
+    }
+
+    u32 base = 10;
+
+    if (text.size() > 1 && text[0] == '0') {
+        if (text[1] == 'x' || text[1] == 'X') {
+            base = 16;
+            text.remove_prefix(2);
+        } else if (text[1] == 'b' || text[1] == 'B') {
+            base = 2;
+            text.remove_prefix(2);
+        } else {
+            base = 8;
+            text.remove_prefix(1);
+        }
+    }
+
+    u64 magnitude = 0;
+    auto [end, err] = std::from_chars(text.data(), text.data() + text.size(), magnitude, base);
+
+    if (text.empty() || err != std::errc() || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+
+    if (negative) {
+        if (magnitude > u64(std::numeric_limits<i64>::max()) + 1) {
+            return std::nullopt;
+        }
+
+        return i64(0 - magnitude);
+    }
+
+    if (magnitude > u64(std::numeric_limits<i64>::max())) {
+        return std::nullopt;
+    }
+
+    return i64(magnitude);
+}
+
+/// the result of `a + b` in `out`, \returns true (leaving `out` alone) if it does not fit in `T`
+template <typename T>
+bool add_overflow(T a, T b, T &out) {
+    if ((b > 0 && a > std::numeric_limits<T>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<T>::min() - b)) {
+        return true;
+    }
+
+    out = T(a + b);
+    return false;
+}
+
+/// the result of `a - b` in `out`, \returns true (leaving `out` alone) if it does not fit in `T`
+template <typename T>
+bool sub_overflow(T a, T b, T &out) {
+    if ((b < 0 && a > std::numeric_limits<T>::max() + b) ||
+        (b > 0 && a < std::numeric_limits<T>::min() + b)) {
+        return true;
+    }
+
+    out = T(a - b);
+    return false;
+}
+
+/// the result of `a * b` in `out`, \returns true (leaving `out` alone) if it does not fit in `T`
+template <typename T>
+bool mul_overflow(T a, T b, T &out) {
+    constexpr T max = std::numeric_limits<T>::max();
+    constexpr T min = std::numeric_limits<T>::min();
+
+    // each bound is divided by an operand that is not 0, so none of the checks overflow
+    const bool overflow = a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                                : (b > 0 ? a < min / b : a != 0 && b < max / a);
+
+    if (overflow) {
+        return true;
+    }
+
+    out = T(a * b);
+    return false;
+}
+
+Constant int_constant(u8 width, i64 value) {
+    Constant constant;
+    constant.kind    = Constant::Kind::Int;
+    constant.width   = width;
+    constant.integer = value;
+
+    return constant;
+}
+
+Constant float_constant(float value) {
+    Constant constant;
+    constant.kind = Constant::Kind::Float;
+    constant.real = value;
+
+    return constant;
+}
+
+Constant bool_constant(bool value) {
+    Constant constant;
+    constant.kind    = Constant::Kind::Bool;
+    constant.boolean = value;
+
+    return constant;
+}
+
+Constant string_constant(std::string value) {
+    Constant constant;
+    constant.kind   = Constant::Kind::String;
+    constant.string = std::move(value);
+
+    return constant;
+}
+
+bool same_type(const Constant &lhs, const Constant &rhs) {
+    return lhs.kind == rhs.kind && (lhs.kind != Constant::Kind::Int || lhs.width == rhs.width);
+}
+
+const char *int_type(u8 width) { return width == 32 ? "i32" : "i64"; }
+
+/// c++ precedence, higher binds tighter. 0 for anything that is not folded
+int binding_power(__TOKEN_N::tokens op) {
+    switch (op) {
+        case __TOKEN_N::OPERATOR_MUL:
+        case __TOKEN_N::OPERATOR_DIV:
+        case __TOKEN_N::OPERATOR_MOD:
+            return 10;
+        case __TOKEN_N::OPERATOR_ADD:
+        case __TOKEN_N::OPERATOR_SUB:
+            return 9;
+        case __TOKEN_N::OPERATOR_BITWISE_L_SHIFT:
+        case __TOKEN_N::OPERATOR_BITWISE_R_SHIFT:
+            return 8;
+        case __TOKEN_N::PUNCTUATION_OPEN_ANGLE:
+        case __TOKEN_N::PUNCTUATION_CLOSE_ANGLE:
+        case __TOKEN_N::OPERATOR_LESS_THAN_EQUALS:
+        case __TOKEN_N::OPERATOR_GREATER_THAN_EQUALS:
+            return 7;
+        case __TOKEN_N::OPERATOR_EQUAL:
+        case __TOKEN_N::OPERATOR_NOT_EQUAL:
+            return 6;
+        case __TOKEN_N::OPERATOR_BITWISE_AND:
+            return 5;
+        case __TOKEN_N::OPERATOR_BITWISE_XOR:
+            return 4;
+        case __TOKEN_N::OPERATOR_BITWISE_OR:
+            return 3;
+        case __TOKEN_N::OPERATOR_LOGICAL_AND:
+            return 2;
+        case __TOKEN_N::OPERATOR_LOGICAL_OR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+bool is_assignment(__TOKEN_N::tokens op) {
+    switch (op) {
+        case __TOKEN_N::OPERATOR_ASSIGN:
+        case __TOKEN_N::OPERATOR_ADD_ASSIGN:
+        case __TOKEN_N::OPERATOR_SUB_ASSIGN:
+        case __TOKEN_N::OPERATOR_MUL_ASSIGN:
+        case __TOKEN_N::OPERATOR_DIV_ASSIGN:
+        case __TOKEN_N::OPERATOR_MOD_ASSIGN:
+        case __TOKEN_N::OPERATOR_MAT_ASSIGN:
+        case __TOKEN_N::OPERATOR_POWER_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_AND_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_OR_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_XOR_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_NOT_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_NOR_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_NAND_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_L_SHIFT_ASSIGN:
+        case __TOKEN_N::OPERATOR_BITWISE_R_SHIFT_ASSIGN:
+        case __TOKEN_N::OPERATOR_AND_ASSIGN:
+        case __TOKEN_N::OPERATOR_NAND_ASSIGN:
+        case __TOKEN_N::OPERATOR_OR_ASSIGN:
+        case __TOKEN_N::OPERATOR_NOR_ASSIGN:
+        case __TOKEN_N::OPERATOR_XOR_ASSIGN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// `"\x1" + "2"` must not become `"\x12"`, so refuse to join when the left side ends in a
+/// numeric escape and the right side starts with something that would extend it
+bool can_join(const std::string &lhs, const std::string &rhs) {
+    if (rhs.empty() || std::isxdigit(static_cast<unsigned char>(rhs.front())) == 0) {
+        return true;
+    }
+
+    const size_t slash = lhs.rfind('\\');
+    return slash == std::string::npos || lhs.size() - slash > 10;
+}
+
+void report(const __TOKEN_N::Token &tok,
+            double                  code,
+            std::vector<std::string> err_args = {},
+            std::vector<std::string> fix_args = {}) {
+    error::Panic(error::CodeError{
+        .pof      = const_cast<__TOKEN_N::Token *>(&tok),
+        .err_code = code,
+        .mark_pof = true,
+        .fix_fmt_args{std::move(fix_args)},
+        .err_fmt_args{std::move(err_args)},
+        .opt_fixes{},
+    });
+}
+
+__AST_N::NodeT<> make_literal(const Constant &value, const __TOKEN_N::Token &loc) {
+    using LiteralType = __AST_NODE::LiteralExpr::LiteralType;
+
+    switch (value.kind) {
+        case Constant::Kind::Int:
+            return __AST_N::make_node<__AST_NODE::LiteralExpr>(
+                __TOKEN_N::Token(__TOKEN_N::LITERAL_INTEGER, std::to_string(value.integer), loc),
+                LiteralType::Integer);
+
+        case Constant::Kind::Float: {
+            // the exact value of the float as a double, so f32(...) round trips bit for bit
+            std::array<char, 64> buf{};
+            auto [end, err] = std::to_chars(buf.data(), buf.data() + buf.size(), double(value.real));
+            std::string text(buf.data(), end);
+
+            if (text.find_first_of(".e") == std::string::npos) {
+                text += ".0";
+            }
+
+            return __AST_N::make_node<__AST_NODE::LiteralExpr>(
+                __TOKEN_N::Token(__TOKEN_N::LITERAL_FLOATING_POINT, text, loc), LiteralType::Float);
+        }
+
+        case Constant::Kind::Bool:
+            return __AST_N::make_node<__AST_NODE::LiteralExpr>(
+                __TOKEN_N::Token(value.boolean ? __TOKEN_N::LITERAL_TRUE : __TOKEN_N::LITERAL_FALSE,
+                                 value.boolean ? "true" : "false",
+                                 loc),
+                LiteralType::Boolean);
+
+        case Constant::Kind::String:
+            return __AST_N::make_node<__AST_NODE::LiteralExpr>(
+                __TOKEN_N::Token(__TOKEN_N::LITERAL_STRING, '"' + value.string + '"', loc),
+                LiteralType::String);
+    }
+
+    return nullptr;
+}
+
+/// the type name a constant binding must be declared with for it to be propagated, a different
+/// declared type would change the type of every use
+bool matches_declared(const Constant &value, const __AST_N::NodeT<__AST_NODE::Type> &type) {
+    if (type == nullptr || type->value == nullptr || type->generics != nullptr || type->nullable ||
+        type->is_fn_ptr || !type->specifiers.modifiers.empty() ||
+        type->value->getNodeType() != __AST_NODE::nodes::IdentExpr) {
+        return false;
+    }
+
+    const std::string &name = __AST_N::as<__AST_NODE::IdentExpr>(type->value)->name.value();
+
+    switch (value.kind) {
+        case Constant::Kind::Int:
+            return name == int_type(value.width);
+        case Constant::Kind::Float:
+            return name == "f32";
+        case Constant::Kind::Bool:
+            return name == "bool";
+        case Constant::Kind::String:
+            return false;
+    }
+
+    return false;
+}
+
+bool needs_parens(const __AST_N::NodeT<> &node) {
+    switch (node->getNodeType()) {
+        case __AST_NODE::nodes::BinaryExpr:
+        case __AST_NODE::nodes::TernaryExpr:
+        case __AST_NODE::nodes::CastExpr:
+        case __AST_NODE::nodes::InstOfExpr:
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+__AST_VISITOR_BEGIN {
+    std::optional<Constant> ConstFold::literal_value(const __AST_NODE::LiteralExpr &literal) {
+        if (literal.contains_format_args) {
+            return std::nullopt;
+        }
+
+        const std::string &text = literal.value.value();
+
+        switch (literal.value.token_kind()) {
+            case __TOKEN_N::LITERAL_INTEGER: {
+                std::optional<i64> value = parse_int(text);
+
+                if (!value) {
+                    return std::nullopt;
+                }
+
+                std::optional<u8> width = int_width(*value);
+
+                if (!width) {
+                    return std::nullopt;
+                }
+
+                return int_constant(*width, *value);
+            }
+
+            case __TOKEN_N::LITERAL_FLOATING_POINT: {
+                char              *end   = nullptr;
+                const long double  value = std::strtold(text.c_str(), &end);
+
+                // only what cx-ir emits as f32(...), the literal itself is a double in c++
+                if (*end != '\0' || std::fabs(value) > std::numeric_limits<float>::max()) {
+                    return std::nullopt;
+                }
+
+                return float_constant(static_cast<float>(std::strtod(text.c_str(), nullptr)));
+            }
+
+            case __TOKEN_N::LITERAL_TRUE:
+            case __TOKEN_N::LITERAL_FALSE:
+                return bool_constant(literal.value.token_kind() == __TOKEN_N::LITERAL_TRUE);
+
+            case __TOKEN_N::LITERAL_STRING:
+                // raw, byte and other prefixed strings are left alone
+                if (text.size() < 2 || text.front() != '"' || text.back() != '"') {
+                    return std::nullopt;
+                }
+
+                return string_constant(text.substr(1, text.size() - 2));
+
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::optional<Constant> ConstFold::fold(const NodeT<> &slot) {
+        if (slot == nullptr) {
+            return std::nullopt;
+        }
+
+        result.reset();
+        replacement.reset();
+
+        slot->accept(*this);
+
+        std::optional<Constant> value = std::exchange(result, std::nullopt);
+        NodeT<>                 node  = std::exchange(replacement, nullptr);
+        auto                   &target = const_cast<NodeT<> &>(slot);
+
+        if (node != nullptr) {
+            target = std::move(node);
+        }
+
+        if (value && target->getNodeType() != __AST_NODE::nodes::LiteralExpr) {
+            target = make_literal(*value, at);
+        }
+
+        return value;
+    }
+
+    void ConstFold::bind(const std::string &name, std::optional<Constant> value) {
+        if (!scopes.empty()) {
+            scopes.back().names[name] = std::move(value);
+        }
+    }
+
+    std::optional<Constant> ConstFold::lookup(const std::string &name) const {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+            if (auto found = scope->names.find(name); found != scope->names.end()) {
+                return found->second;
+            }
+
+            if (scope->opaque) {
+                break;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<Constant> ConstFold::apply(
+        const Constant &lhs, const __TOKEN_N::Token &op, const Constant &rhs) {
+        const __TOKEN_N::tokens kind = op.token_kind();
+
+        auto compare = [&](auto a, auto b) -> std::optional<Constant> {
+            bool value = false;
+
+            switch (kind) {
+                case __TOKEN_N::OPERATOR_EQUAL:
+                    value = a == b;
+                    break;
+                case __TOKEN_N::OPERATOR_NOT_EQUAL:
+                    value = a != b;
+                    break;
+                case __TOKEN_N::PUNCTUATION_OPEN_ANGLE:
+                    value = a < b;
+                    break;
+                case __TOKEN_N::PUNCTUATION_CLOSE_ANGLE:
+                    value = a > b;
+                    break;
+                case __TOKEN_N::OPERATOR_LESS_THAN_EQUALS:
+                    value = a <= b;
+                    break;
+                case __TOKEN_N::OPERATOR_GREATER_THAN_EQUALS:
+                    value = a >= b;
+                    break;
+                default:
+                    return std::nullopt;
+            }
+
+            return bool_constant(value);
+        };
+
+        if (lhs.kind == Constant::Kind::Int && rhs.kind == Constant::Kind::Int) {
+            if (binding_power(kind) == 7 || binding_power(kind) == 6) {
+                return compare(lhs.integer, rhs.integer);
+            }
+
+            // shifts take the type of the left operand, everything else the wider one
+            const bool shift = kind == __TOKEN_N::OPERATOR_BITWISE_L_SHIFT ||
+                               kind == __TOKEN_N::OPERATOR_BITWISE_R_SHIFT;
+            const u8   width = shift ? lhs.width : std::max(lhs.width, rhs.width);
+
+            // checked before the count is narrowed to the type of the left operand
+            if (shift && (rhs.integer < 0 || rhs.integer >= width)) {
+                report(op, 5.1006, {std::to_string(rhs.integer), int_type(width)});
+                return std::nullopt;
+            }
+
+            auto eval = [&]<typename T>(T a, T b) -> std::optional<Constant> {
+                using U = std::make_unsigned_t<T>;
+                T    out{};
+                bool overflow = false;
+
+                switch (kind) {
+                    case __TOKEN_N::OPERATOR_ADD:
+                        overflow = add_overflow(a, b, out);
+                        break;
+                    case __TOKEN_N::OPERATOR_SUB:
+                        overflow = sub_overflow(a, b, out);
+                        break;
+                    case __TOKEN_N::OPERATOR_MUL:
+                        overflow = mul_overflow(a, b, out);
+                        break;
+                    case __TOKEN_N::OPERATOR_DIV:
+                    case __TOKEN_N::OPERATOR_MOD:
+                        if (b == 0) {
+                            report(op, 5.1005);
+                            return std::nullopt;
+                        }
+
+                        if (a == std::numeric_limits<T>::min() && b == -1) {
+                            overflow = true;
+                            break;
+                        }
+
+                        out = kind == __TOKEN_N::OPERATOR_DIV ? a / b : a % b;
+                        break;
+                    case __TOKEN_N::OPERATOR_BITWISE_L_SHIFT:
+                    case __TOKEN_N::OPERATOR_BITWISE_R_SHIFT:
+                        // in range, see above. well defined (modular) since c++20
+                        out = kind == __TOKEN_N::OPERATOR_BITWISE_L_SHIFT ? T(U(a) << b) : T(a >> b);
+                        break;
+                    case __TOKEN_N::OPERATOR_BITWISE_AND:
+                        out = a & b;
+                        break;
+                    case __TOKEN_N::OPERATOR_BITWISE_OR:
+                        out = a | b;
+                        break;
+                    case __TOKEN_N::OPERATOR_BITWISE_XOR:
+                        out = a ^ b;
+                        break;
+                    default:
+                        return std::nullopt;
+                }
+
+                if (overflow) {
+                    report(op, 5.1004, {int_type(width)}, {int_type(width)});
+                    return std::nullopt;
+                }
+
+                return int_constant(width, i64(out));
+            };
+
+            if (width == 32) {
+                return eval(i32(lhs.integer), i32(rhs.integer));
+            }
+
+            return eval(i64(lhs.integer), i64(rhs.integer));
+        }
+
+        if (lhs.kind == Constant::Kind::Float && rhs.kind == Constant::Kind::Float) {
+            float value = 0;
+
+            switch (kind) {
+                case __TOKEN_N::OPERATOR_ADD:
+                    value = lhs.real + rhs.real;
+                    break;
+                case __TOKEN_N::OPERATOR_SUB:
+                    value = lhs.real - rhs.real;
+                    break;
+                case __TOKEN_N::OPERATOR_MUL:
+                    value = lhs.real * rhs.real;
+                    break;
+                case __TOKEN_N::OPERATOR_DIV:
+                    value = lhs.real / rhs.real;
+                    break;
+                default:
+                    return compare(lhs.real, rhs.real);
+            }
+
+            // inf and nan have no literal spelling, leave those to the c++ compiler
+            if (!std::isfinite(value)) {
+                return std::nullopt;
+            }
+
+            return float_constant(value);
+        }
+
+        if (lhs.kind == Constant::Kind::Bool && rhs.kind == Constant::Kind::Bool) {
+            switch (kind) {
+                case __TOKEN_N::OPERATOR_LOGICAL_AND:
+                    return bool_constant(lhs.boolean && rhs.boolean);
+                case __TOKEN_N::OPERATOR_LOGICAL_OR:
+                    return bool_constant(lhs.boolean || rhs.boolean);
+                case __TOKEN_N::OPERATOR_EQUAL:
+                case __TOKEN_N::OPERATOR_NOT_EQUAL:
+                    return compare(lhs.boolean, rhs.boolean);
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        if (lhs.kind == Constant::Kind::String && rhs.kind == Constant::Kind::String &&
+            kind == __TOKEN_N::OPERATOR_ADD && can_join(lhs.string, rhs.string)) {
+            return string_constant(lhs.string + rhs.string);
+        }
+
+        return std::nullopt;
+    }
+
+    void ConstFold::fold_chain(const __AST_NODE::BinaryExpr &root) {
+        // flatten the chain in emission order, ranges and `in` are emitted as calls so they
+        // delimit their operands just like parentheses do
+        std::vector<const NodeT<> *>           operands;
+        std::vector<const __TOKEN_N::Token *> ops;
+
+        auto flatten = [&](auto &self, const NodeT<> &slot) -> void {
+            if (slot != nullptr && slot->getNodeType() == __AST_NODE::nodes::BinaryExpr) {
+                const auto &expr = *__AST_N::as<__AST_NODE::BinaryExpr>(slot);
+
+                if (binding_power(expr.op.token_kind()) != 0) {
+                    self(self, expr.lhs);
+                    ops.push_back(&expr.op);
+                    self(self, expr.rhs);
+                    return;
+                }
+            }
+
+            operands.push_back(&slot);
+        };
+
+        flatten(flatten, root.lhs);
+        ops.push_back(&root.op);
+        flatten(flatten, root.rhs);
+
+        std::vector<std::optional<Constant>> values;
+        bool                                 constant = true;
+
+        for (const NodeT<> *operand : operands) {
+            if (*operand != nullptr && (*operand)->getNodeType() == __AST_NODE::nodes::TernaryExpr) {
+                chain_operand = true;
+            }
+
+            values.push_back(fold(*operand));
+            constant = constant && values.back().has_value();
+        }
+
+        chain_operand = false;
+
+        if (!constant) {
+            return;
+        }
+
+        size_t next = 0;
+
+        // precedence climbing over the flat chain, left associative like c++
+        auto climb = [&](auto &self, Constant lhs, int min_power) -> std::optional<Constant> {
+            while (next < ops.size() && binding_power(ops[next]->token_kind()) >= min_power) {
+                const __TOKEN_N::Token &op    = *ops[next];
+                const int               power = binding_power(op.token_kind());
+                std::optional<Constant> rhs   = values[++next];
+
+                while (next < ops.size() && binding_power(ops[next]->token_kind()) > power) {
+                    rhs = self(self, *rhs, power + 1);
+
+                    if (!rhs) {
+                        return std::nullopt;
+                    }
+                }
+
+                std::optional<Constant> out = apply(lhs, op, *rhs);
+
+                if (!out) {
+                    return std::nullopt;
+                }
+
+                lhs = *out;
+            }
+
+            return lhs;
+        };
+
+        std::optional<Constant> value = climb(climb, *values[0], 1);
+
+        // only fold when the literal is inferred as the type the expression had
+        if (!value || (value->kind == Constant::Kind::Int && int_width(value->integer) != value->width)) {
+            return;
+        }
+
+        at     = __AST_N::as<__AST_NODE::LiteralExpr>(*operands[0])->value;
+        result = value;
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    void ConstFold::visit(const __AST_NODE::LiteralExpr &node) {
+        if (node.contains_format_args) {
+            walk(node.format_args);
+            return;
+        }
+
+        result = literal_value(node);
+        at     = node.value;
+    }
+
+    void ConstFold::visit(const __AST_NODE::BinaryExpr &node) {
+        switch (node.op.token_kind()) {
+            case __TOKEN_N::OPERATOR_RANGE:
+            case __TOKEN_N::OPERATOR_RANGE_INCLUSIVE:
+            case __TOKEN_N::KEYWORD_IN:
+                fold(node.lhs);
+                fold(node.rhs);
+                return;
+
+            default:
+                break;
+        }
+
+        // `x = ...` assigns the whole right hand side, so both sides are separate chains
+        if (is_assignment(node.op.token_kind())) {
+            keep(node.lhs);
+            fold(node.rhs);
+            return;
+        }
+
+        fold_chain(node);
+    }
+
+    void ConstFold::visit(const __AST_NODE::UnaryExpr &node) {
+        if (node.in_type || node.type == __AST_NODE::UnaryExpr::PosType::PostFix) {
+            keep(node.opd);
+            return;
+        }
+
+        switch (node.op.token_kind()) {
+            case __TOKEN_N::OPERATOR_SUB:
+            case __TOKEN_N::OPERATOR_ADD:
+            case __TOKEN_N::OPERATOR_LOGICAL_NOT:
+            case __TOKEN_N::OPERATOR_BITWISE_NOT:
+                break;
+
+            default:  // address of, dereference, ++, -- need the operand as written
+                keep(node.opd);
+                return;
+        }
+
+        std::optional<Constant> value = fold(node.opd);
+
+        if (!value) {
+            return;
+        }
+
+        switch (node.op.token_kind()) {
+            case __TOKEN_N::OPERATOR_SUB:
+                if (value->kind == Constant::Kind::Float) {
+                    value->real = -value->real;
+                    break;
+                }
+
+                if (value->kind != Constant::Kind::Int) {
+                    return;
+                }
+
+                if (value->integer == (value->width == 32 ? std::numeric_limits<i32>::min()
+                                                          : std::numeric_limits<i64>::min())) {
+                    report(node.op, 5.1004, {int_type(value->width)}, {int_type(value->width)});
+                    return;
+                }
+
+                value->integer = -value->integer;
+                break;
+
+            case __TOKEN_N::OPERATOR_ADD:
+                if (value->kind != Constant::Kind::Int && value->kind != Constant::Kind::Float) {
+                    return;
+                }
+
+                break;
+
+            case __TOKEN_N::OPERATOR_LOGICAL_NOT:
+                if (value->kind != Constant::Kind::Bool) {
+                    return;
+                }
+
+                value->boolean = !value->boolean;
+                break;
+
+            default:  // ~
+                if (value->kind != Constant::Kind::Int) {
+                    return;
+                }
+
+                value->integer = ~value->integer;
+                break;
+        }
+
+        if (value->kind == Constant::Kind::Int && int_width(value->integer) != value->width) {
+            return;
+        }
+
+        at     = node.op;
+        result = value;
+    }
+
+    void ConstFold::visit(const __AST_NODE::IdentExpr &node) {
+        if (std::optional<Constant> value = lookup(node.name.value())) {
+            at     = node.name;
+            result = value;
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::NamedArgumentExpr &node) {
+        walk(node.name);
+        fold(node.value);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ArgumentExpr &node) { fold(node.value); }
+    void ConstFold::visit(const __AST_NODE::ArgumentListExpr &node) { walk(node.args); }
+    void ConstFold::visit(const __AST_NODE::GenericInvokeExpr &node) { walk(node.args); }
+
+    void ConstFold::visit(const __AST_NODE::ScopePathExpr &node) {
+        walk(node.path);
+        keep(node.access);
+    }
+
+    void ConstFold::visit(const __AST_NODE::DotPathExpr &node) {
+        keep(node.lhs);
+        keep(node.rhs);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ArrayAccessExpr &node) {
+        keep(node.lhs);
+        fold(node.rhs);
+    }
+
+    void ConstFold::visit(const __AST_NODE::PathExpr &node) { keep(node.path); }
+
+    void ConstFold::visit(const __AST_NODE::FunctionCallExpr &node) {
+        walk(node.path);
+        walk(node.generic);
+        fold(node.args);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ArrayLiteralExpr &node) { walk(node.values); }
+    void ConstFold::visit(const __AST_NODE::TupleLiteralExpr &node) { walk(node.values); }
+    void ConstFold::visit(const __AST_NODE::SetLiteralExpr &node) { walk(node.values); }
+
+    void ConstFold::visit(const __AST_NODE::MapPairExpr &node) {
+        fold(node.key);
+        fold(node.value);
+    }
+
+    void ConstFold::visit(const __AST_NODE::MapLiteralExpr &node) { walk(node.values); }
+
+    void ConstFold::visit(const __AST_NODE::ObjInitExpr &node) {
+        keep(node.path);
+        walk(node.kwargs);
+    }
+
+    void ConstFold::visit(const __AST_NODE::LambdaExpr &node) {
+        push_scope();
+        walk(node.generics);
+        walk(node.params);
+        walk(node.returns);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::TernaryExpr &node) {
+        // as an operand of a binary chain the ternary is emitted unparenthesized, so the c++
+        // grouping around it is not the one in the tree, leave its shape alone
+        const bool in_chain = std::exchange(chain_operand, false);
+
+        std::optional<Constant> condition = fold(node.condition);
+        std::optional<Constant> if_true   = fold(node.if_true);
+        std::optional<Constant> if_false  = fold(node.if_false);
+
+        if (in_chain || !condition || condition->kind != Constant::Kind::Bool) {
+            return;
+        }
+
+        // `c ? 1 : 2.5` is a double either way, picking a branch would change the type
+        if (if_true && if_false && !same_type(*if_true, *if_false)) {
+            return;
+        }
+
+        const NodeT<>                 &taken = condition->boolean ? node.if_true : node.if_false;
+        const std::optional<Constant> &value = condition->boolean ? if_true : if_false;
+
+        if (value) {
+            at     = __AST_N::as<__AST_NODE::LiteralExpr>(taken)->value;
+            result = value;
+            return;
+        }
+
+        replacement = needs_parens(taken) ? __AST_N::make_node<__AST_NODE::ParenthesizedExpr>(taken)
+                                          : taken;
+    }
+
+    void ConstFold::visit(const __AST_NODE::ParenthesizedExpr &node) {
+        if (std::optional<Constant> value = fold(node.value)) {
+            at     = __AST_N::as<__AST_NODE::LiteralExpr>(node.value)->value;
+            result = value;
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::CastExpr &node) {
+        fold(node.value);
+        walk(node.type);
+    }
+
+    void ConstFold::visit(const __AST_NODE::InstOfExpr &node) {
+        keep(node.value);
+        keep(node.type);
+    }
+
+    void ConstFold::visit(const __AST_NODE::AsyncThreading &node) { fold(node.value); }
+
+    void ConstFold::visit(const __AST_NODE::Type &node) {
+        keep(node.value);
+        walk(node.generics);
+
+        if (node.is_fn_ptr) {
+            walk(node.fn_ptr.params);
+            walk(node.fn_ptr.returns);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    void ConstFold::visit(const __AST_NODE::NamedVarSpecifier &node) {
+        walk(node.type);
+
+        if (node.path != nullptr) {
+            bind(node.path->name.value());
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::NamedVarSpecifierList &node) { walk(node.vars); }
+
+    void ConstFold::visit(const __AST_NODE::ForPyStatementCore &node) {
+        fold(node.range);
+        walk(node.vars);
+        walk(node.body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ForCStatementCore &node) {
+        walk(node.init);
+        fold(node.condition);
+        fold(node.update);
+        walk(node.body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ForState &node) {
+        push_scope();
+        walk(node.core);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::WhileState &node) {
+        fold(node.condition);
+        walk(node.body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ElseState &node) {
+        fold(node.condition);
+        walk(node.body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::IfState &node) {
+        fold(node.condition);
+        walk(node.body);
+        walk(node.else_body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::SwitchCaseState &node) {
+        fold(node.condition);
+        walk(node.body);
+    }
+
+    void ConstFold::visit(const __AST_NODE::SwitchState &node) {
+        fold(node.condition);
+        walk(node.cases);
+    }
+
+    void ConstFold::visit(const __AST_NODE::YieldState &node) { fold(node.value); }
+    void ConstFold::visit(const __AST_NODE::DeleteState &node) { keep(node.value); }
+    void ConstFold::visit(const __AST_NODE::ImportState &) {}
+    void ConstFold::visit(const __AST_NODE::ImportItems &) {}
+    void ConstFold::visit(const __AST_NODE::SingleImport &) {}
+    void ConstFold::visit(const __AST_NODE::SpecImport &) {}
+    void ConstFold::visit(const __AST_NODE::MultiImportState &) {}
+    void ConstFold::visit(const __AST_NODE::ReturnState &node) { fold(node.value); }
+    void ConstFold::visit(const __AST_NODE::BreakState &) {}
+
+    void ConstFold::visit(const __AST_NODE::BlockState &node) {
+        push_scope();
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::SuiteState &node) { walk(node.body); }
+    void ConstFold::visit(const __AST_NODE::ContinueState &) {}
+
+    void ConstFold::visit(const __AST_NODE::CatchState &node) {
+        push_scope();
+        keep(node.catch_state);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::FinallyState &node) { walk(node.body); }
+
+    void ConstFold::visit(const __AST_NODE::TryState &node) {
+        walk(node.body);
+        walk(node.catch_states);
+        walk(node.finally_state);
+    }
+
+    void ConstFold::visit(const __AST_NODE::PanicState &node) { fold(node.expr); }
+    void ConstFold::visit(const __AST_NODE::ExprState &node) { fold(node.value); }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    void ConstFold::visit(const __AST_NODE::RequiresParamDecl &node) {
+        walk(node.var);
+        fold(node.value);
+    }
+
+    void ConstFold::visit(const __AST_NODE::RequiresParamList &node) { walk(node.params); }
+
+    void ConstFold::visit(const __AST_NODE::EnumMemberDecl &node) {
+        fold(node.value);
+
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::UDTDeriveDecl &node) {
+        for (const auto &derive : node.derives) {
+            walk(derive.first);
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::TypeBoundList &node) { walk(node.bounds); }
+    void ConstFold::visit(const __AST_NODE::TypeBoundDecl &node) { walk(node.bound); }
+
+    void ConstFold::visit(const __AST_NODE::RequiresDecl &node) {
+        walk(node.params);
+        walk(node.bounds);
+    }
+
+    void ConstFold::visit(const __AST_NODE::ModuleDecl &node) {
+        push_scope();
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::StructDecl &node) {
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+
+        push_scope(true);
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::ExtendDecl &node) {
+        for (const auto &base : node.extends) {
+            walk(base.first);
+        }
+
+        push_scope(true);
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::ConstDecl &node) {
+        for (const auto &var : node.vars) {
+            const_binding = true;
+            walk(var);
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::ClassDecl &node) {
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+
+        for (const auto &base : node.extends) {
+            walk(base.first);
+        }
+
+        push_scope(true);
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::InterDecl &node) {
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+
+        push_scope(true);
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::EnumDecl &node) {
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+
+        walk(node.derives);
+        walk(node.members);
+    }
+
+    void ConstFold::visit(const __AST_NODE::TypeDecl &node) {
+        if (node.name != nullptr) {
+            bind(node.name->name.value());
+        }
+
+        push_scope();
+        walk(node.generics);
+        walk(node.type);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::FuncDecl &node) {
+        if (node.name != nullptr && node.name->type == __AST_NODE::PathExpr::PathType::Identifier) {
+            bind(node.name->get_back_name().value());
+        }
+
+        push_scope();
+        walk(node.generics);
+        walk(node.params);
+        walk(node.returns);
+        walk(node.body);
+        pop_scope();
+    }
+
+    void ConstFold::visit(const __AST_NODE::VarDecl &node) {
+        const bool is_const = std::exchange(const_binding, false);
+
+        // the name is in scope in its own initializer, so bind it before folding the value
+        walk(node.var);
+        std::optional<Constant> value = fold(node.value);
+
+        if (is_const && value && node.var != nullptr && node.var->path != nullptr &&
+            matches_declared(*value, node.var->type)) {
+            bind(node.var->path->name.value(), value);
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::FFIDecl &) {}
+
+    void ConstFold::visit(const __AST_NODE::LetDecl &node) {
+        const bool eval = node.modifiers.contains(__TOKEN_N::KEYWORD_EVAL);
+
+        for (const auto &var : node.vars) {
+            const_binding = eval;
+            walk(var);
+        }
+    }
+
+    void ConstFold::visit(const __AST_NODE::OpDecl &node) { walk(node.func); }
+
+    void ConstFold::visit(const __AST_NODE::Program &node) {
+        push_scope();
+        walk(node.children);
+        pop_scope();
+    }
+}  // namespace __AST_VISITOR_BEGIN
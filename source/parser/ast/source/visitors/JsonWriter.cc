@@ -0,0 +1,210 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <cstring>
+#include <utility>
+
+#include "glaze-json/include/glaze/beve/write.hpp"
+#include "glaze-json/include/glaze/json/write.hpp"
+#include "parser/ast/include/types/AST_json_writer.hh"
+
+namespace {
+constexpr glz::opts json_opts{};
+constexpr glz::opts beve_opts{.format = glz::BEVE};
+
+/// beve counts are written as a fixed 4 byte compressed int so they can be patched once the
+/// container is closed, the reader accepts any width so this is still valid beve.
+constexpr size_t  count_width = sizeof(u32);
+constexpr uint8_t count_4byte = 2;
+
+/// glz::tag::null, spelled out since `null` is a macro in AST_config.def
+constexpr uint8_t beve_null = 0;
+}  // namespace
+
+__AST_VISITOR_BEGIN {
+    JsonWriter::JsonWriter(JsonFormat format, std::FILE *sink)
+        : fmt(format)
+        , sink(sink) {
+        buf.resize(flush_threshold * 2);
+        stack.reserve(64);
+    }
+
+    JsonWriter::~JsonWriter() {
+        if (sink != nullptr) {
+            flush();
+        }
+    }
+
+    void JsonWriter::element() {
+        if (stack.empty()) {
+            return;
+        }
+
+        Frame &top = stack.back();
+
+        if (top.is_object) {  // the key already accounted for this value
+            return;
+        }
+
+        if (fmt == JsonFormat::JSON && top.count != 0) {
+            glz::detail::dump<','>(buf, ix);
+        }
+
+        ++top.count;
+    }
+
+    void JsonWriter::begin_object() {
+        element();
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::dump<'{'>(buf, ix);
+            stack.push_back({0, 0, true});
+            return;
+        }
+
+        glz::detail::dump_type(glz::tag::object, buf, ix);
+        stack.push_back({ix, 0, true});
+        glz::detail::dump_type(u32(0), buf, ix);
+    }
+
+    void JsonWriter::begin_array() {
+        element();
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::dump<'['>(buf, ix);
+            stack.push_back({0, 0, false});
+            return;
+        }
+
+        glz::detail::dump_type(glz::tag::generic_array, buf, ix);
+        stack.push_back({ix, 0, false});
+        glz::detail::dump_type(u32(0), buf, ix);
+    }
+
+    void JsonWriter::close(bool is_object) {
+        Frame top = stack.back();
+        stack.pop_back();
+
+        if (fmt == JsonFormat::JSON) {
+            if (is_object) {
+                glz::detail::dump<'}'>(buf, ix);
+            } else {
+                glz::detail::dump<']'>(buf, ix);
+            }
+        } else {
+            const u32 count = count_4byte | (top.count << 2);
+            std::memcpy(buf.data() + top.count_at, &count, count_width);
+        }
+
+        maybe_flush();
+    }
+
+    void JsonWriter::end_object() { close(true); }
+    void JsonWriter::end_array() { close(false); }
+
+    void JsonWriter::key(std::string_view key) {
+        Frame &top = stack.back();
+        glz::context ctx{};
+
+        if (fmt == JsonFormat::JSON) {
+            if (top.count != 0) {
+                glz::detail::dump<','>(buf, ix);
+            }
+
+            glz::detail::write<glz::JSON>::op<json_opts>(key, ctx, buf, ix);
+            glz::detail::dump<':'>(buf, ix);
+        } else {
+            glz::detail::write<glz::BEVE>::no_header<beve_opts>(key, ctx, buf, ix);
+        }
+
+        ++top.count;
+    }
+
+    void JsonWriter::value(std::string_view val) {
+        element();
+        glz::context ctx{};
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::write<glz::JSON>::op<json_opts>(val, ctx, buf, ix);
+        } else {
+            glz::detail::write<glz::BEVE>::op<beve_opts>(val, ctx, buf, ix);
+        }
+    }
+
+    void JsonWriter::value(i64 val) {
+        element();
+        glz::context ctx{};
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::write<glz::JSON>::op<json_opts>(val, ctx, buf, ix);
+        } else {
+            glz::detail::write<glz::BEVE>::op<beve_opts>(val, ctx, buf, ix);
+        }
+    }
+
+    void JsonWriter::value(bool val) {
+        element();
+        glz::context ctx{};
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::write<glz::JSON>::op<json_opts>(val, ctx, buf, ix);
+        } else {
+            glz::detail::write<glz::BEVE>::op<beve_opts>(val, ctx, buf, ix);
+        }
+    }
+
+    void JsonWriter::value(std::nullptr_t) {
+        element();
+
+        if (fmt == JsonFormat::JSON) {
+            glz::detail::dump<"null">(buf, ix);
+        } else {
+            glz::detail::dump_type(beve_null, buf, ix);
+        }
+    }
+
+    void JsonWriter::maybe_flush() {
+        if (sink == nullptr || ix < flush_threshold) {
+            return;
+        }
+
+        // beve containers still have unpatched counts, so only flush once everything is closed
+        if (fmt == JsonFormat::BEVE && !stack.empty()) {
+            return;
+        }
+
+        flush();
+    }
+
+    void JsonWriter::flush() {
+        if (sink == nullptr || ix == 0) {
+            return;
+        }
+
+        if (fmt == JsonFormat::BEVE && !stack.empty()) {
+            return;
+        }
+
+        std::fwrite(buf.data(), 1, ix, sink);
+        std::fflush(sink);
+        ix = 0;
+    }
+
+    std::string JsonWriter::take() {
+        std::string out(buf.data(), ix);
+        ix = 0;
+        return out;
+    }
+}  // namespace __AST_VISITOR_BEGIN
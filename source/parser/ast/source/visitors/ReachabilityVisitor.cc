@@ -0,0 +1,519 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <cctype>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/private/base/AST_base.hh"
+#include "parser/ast/include/types/AST_reachability_visitor.hh"
+
+namespace {
+using NameSet = __AST_VISITOR::NameSet;
+
+struct Symbol {
+    __AST_N::NodeV<>        *owner;  // the declaration list the node lives in
+    __AST_N::NodeT<>         node;
+    std::vector<std::string> names;  // empty for declarations that are always kept
+    NameSet                  refs;
+    bool                     live = false;
+};
+
+bool is_ident_start(char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_'; }
+bool is_ident_char(char c) { return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_'; }
+
+std::vector<std::string> introduced(const __AST_N::NodeT<> &decl) {
+    std::vector<std::string> names;
+
+    auto add = [&names](const auto &ident) {
+        if (ident != nullptr) {
+            names.push_back(ident->name.value());
+        }
+    };
+
+    switch (decl->getNodeType()) {
+        case __AST_NODE::nodes::FuncDecl: {
+            // `fn Foo::bar()` is kept along with `Foo`, so every part of the path is a key
+            for (const auto &part : __AST_N::as<__AST_NODE::FuncDecl>(decl)->get_name_t()) {
+                names.push_back(part.current().get().value());
+            }
+
+            break;
+        }
+
+        case __AST_NODE::nodes::ClassDecl:
+            add(__AST_N::as<__AST_NODE::ClassDecl>(decl)->name);
+            break;
+
+        case __AST_NODE::nodes::StructDecl:
+            add(__AST_N::as<__AST_NODE::StructDecl>(decl)->name);
+            break;
+
+        case __AST_NODE::nodes::InterDecl:
+            add(__AST_N::as<__AST_NODE::InterDecl>(decl)->name);
+            break;
+
+        case __AST_NODE::nodes::TypeDecl:
+            add(__AST_N::as<__AST_NODE::TypeDecl>(decl)->name);
+            break;
+
+        case __AST_NODE::nodes::ExtendDecl:  // lives and dies with the type it extends
+            add(__AST_N::as<__AST_NODE::ExtendDecl>(decl)->name);
+            break;
+
+        case __AST_NODE::nodes::EnumDecl: {
+            auto enum_decl = __AST_N::as<__AST_NODE::EnumDecl>(decl);
+            add(enum_decl->name);
+
+            // unscoped members are used without the enum name
+            for (const auto &member : enum_decl->members) {
+                if (member != nullptr) {
+                    add(member->name);
+                }
+            }
+
+            break;
+        }
+
+        case __AST_NODE::nodes::LetDecl:
+        case __AST_NODE::nodes::ConstDecl: {
+            const auto &vars = decl->getNodeType() == __AST_NODE::nodes::LetDecl
+                                   ? __AST_N::as<__AST_NODE::LetDecl>(decl)->vars
+                                   : __AST_N::as<__AST_NODE::ConstDecl>(decl)->vars;
+
+            for (const auto &var : vars) {
+                if (var != nullptr && var->var != nullptr) {
+                    add(var->var->path);
+                }
+            }
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return names;
+}
+
+void collect(__AST_N::NodeV<> &decls, std::vector<Symbol> &symbols) {
+    for (auto &decl : decls) {
+        if (decl == nullptr) {
+            continue;
+        }
+
+        // a module is only a namespace, aliases and `using namespace` name it from inside
+        // strings, so the module itself always stays and its members are pruned one by one
+        if (decl->getNodeType() == __AST_NODE::nodes::ModuleDecl) {
+            auto module = __AST_N::as<__AST_NODE::ModuleDecl>(decl);
+
+            if (module->body != nullptr && module->body->body != nullptr) {
+                collect(module->body->body->body, symbols);
+                continue;
+            }
+        }
+
+        __AST_VISITOR::References refs;
+        decl->accept(refs);
+
+        symbols.push_back(Symbol{
+            .owner = &decls,
+            .node  = decl,
+            .names = introduced(decl),
+            .refs  = std::move(refs.names),
+        });
+    }
+}
+}  // namespace
+
+__AST_VISITOR_BEGIN {
+    NameSet references(const __AST_NODE::Program &program) {
+        References refs;
+        program.accept(refs);
+
+        return std::move(refs.names);
+    }
+
+    NameSet prune_unreachable(__AST_NODE::Program & program, const NameSet &roots) {
+        std::vector<Symbol> symbols;
+        collect(program.children, symbols);
+
+        std::unordered_map<std::string, std::vector<size_t>> by_name;
+        std::vector<size_t>                                  queue;
+        NameSet                                              live = roots;
+
+        auto mark = [&](size_t index) {
+            if (!symbols[index].live) {
+                symbols[index].live = true;
+                queue.push_back(index);
+            }
+        };
+
+        for (size_t index = 0; index < symbols.size(); ++index) {
+            if (symbols[index].names.empty()) {
+                mark(index);
+                continue;
+            }
+
+            for (const auto &name : symbols[index].names) {
+                by_name[name].push_back(index);
+
+                if (live.contains(name)) {
+                    mark(index);
+                }
+            }
+        }
+
+        while (!queue.empty()) {
+            const size_t index = queue.back();
+            queue.pop_back();
+
+            for (const auto &ref : symbols[index].refs) {
+                if (!live.insert(ref).second) {
+                    continue;
+                }
+
+                if (auto found = by_name.find(ref); found != by_name.end()) {
+                    for (const size_t other : found->second) {
+                        mark(other);
+                    }
+                }
+            }
+        }
+
+        std::unordered_set<const __AST_NODE::Node *> dead;
+
+        for (const auto &symbol : symbols) {
+            if (!symbol.live) {
+                dead.insert(symbol.node.get());
+            }
+        }
+
+        if (dead.empty()) {
+            return live;
+        }
+
+        std::unordered_set<NodeV<> *> owners;
+
+        for (const auto &symbol : symbols) {
+            owners.insert(symbol.owner);
+        }
+
+        for (NodeV<> *owner : owners) {
+            std::erase_if(*owner, [&dead](const NodeT<> &node) { return dead.contains(node.get()); });
+        }
+
+        return live;
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    void References::visit(const __AST_NODE::LiteralExpr &node) {
+        walk(node.format_args);
+
+        if (!inline_cpp || node.value.token_kind() != __TOKEN_N::LITERAL_STRING) {
+            return;
+        }
+
+        const std::string &text = node.value.value();
+
+        for (size_t pos = 0; pos < text.size();) {
+            if (!is_ident_start(text[pos])) {
+                ++pos;
+                continue;
+            }
+
+            const size_t start = pos;
+
+            while (pos < text.size() && is_ident_char(text[pos])) {
+                ++pos;
+            }
+
+            names.insert(text.substr(start, pos - start));
+        }
+    }
+
+    void References::visit(const __AST_NODE::BinaryExpr &node) {
+        walk(node.lhs);
+        walk(node.rhs);
+    }
+
+    void References::visit(const __AST_NODE::UnaryExpr &node) { walk(node.opd); }
+    void References::visit(const __AST_NODE::IdentExpr &node) { add(node.name); }
+    void References::visit(const __AST_NODE::NamedArgumentExpr &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::ArgumentExpr &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::ArgumentListExpr &node) { walk(node.args); }
+    void References::visit(const __AST_NODE::GenericInvokeExpr &node) { walk(node.args); }
+
+    void References::visit(const __AST_NODE::ScopePathExpr &node) {
+        walk(node.path);
+        walk(node.access);
+    }
+
+    void References::visit(const __AST_NODE::DotPathExpr &node) {
+        walk(node.lhs);
+        walk(node.rhs);
+    }
+
+    void References::visit(const __AST_NODE::ArrayAccessExpr &node) {
+        walk(node.lhs);
+        walk(node.rhs);
+    }
+
+    void References::visit(const __AST_NODE::PathExpr &node) { walk(node.path); }
+
+    void References::visit(const __AST_NODE::FunctionCallExpr &node) {
+        walk(node.path);
+        walk(node.generic);
+
+        const bool is_inline_cpp = node.path != nullptr &&
+                                   node.path->type == __AST_NODE::PathExpr::PathType::Identifier &&
+                                   node.path->get_back_name().value() == "__inline_cpp";
+
+        const bool outer = std::exchange(inline_cpp, is_inline_cpp);
+        walk(node.args);
+        inline_cpp = outer;
+    }
+
+    void References::visit(const __AST_NODE::ArrayLiteralExpr &node) { walk(node.values); }
+    void References::visit(const __AST_NODE::TupleLiteralExpr &node) { walk(node.values); }
+    void References::visit(const __AST_NODE::SetLiteralExpr &node) { walk(node.values); }
+
+    void References::visit(const __AST_NODE::MapPairExpr &node) {
+        walk(node.key);
+        walk(node.value);
+    }
+
+    void References::visit(const __AST_NODE::MapLiteralExpr &node) { walk(node.values); }
+
+    void References::visit(const __AST_NODE::ObjInitExpr &node) {
+        walk(node.path);
+        walk(node.kwargs);
+    }
+
+    void References::visit(const __AST_NODE::LambdaExpr &node) {
+        walk(node.generics);
+        walk(node.params);
+        walk(node.returns);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::TernaryExpr &node) {
+        walk(node.condition);
+        walk(node.if_true);
+        walk(node.if_false);
+    }
+
+    void References::visit(const __AST_NODE::ParenthesizedExpr &node) { walk(node.value); }
+
+    void References::visit(const __AST_NODE::CastExpr &node) {
+        walk(node.value);
+        walk(node.type);
+    }
+
+    void References::visit(const __AST_NODE::InstOfExpr &node) {
+        walk(node.value);
+        walk(node.type);
+    }
+
+    void References::visit(const __AST_NODE::AsyncThreading &node) { walk(node.value); }
+
+    void References::visit(const __AST_NODE::Type &node) {
+        walk(node.value);
+        walk(node.generics);
+
+        if (node.is_fn_ptr) {
+            walk(node.fn_ptr.params);
+            walk(node.fn_ptr.returns);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    // declaration sites only contribute their types, the name itself is not a use
+    void References::visit(const __AST_NODE::NamedVarSpecifier &node) { walk(node.type); }
+    void References::visit(const __AST_NODE::NamedVarSpecifierList &node) { walk(node.vars); }
+
+    void References::visit(const __AST_NODE::ForPyStatementCore &node) {
+        walk(node.vars);
+        walk(node.range);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::ForCStatementCore &node) {
+        walk(node.init);
+        walk(node.condition);
+        walk(node.update);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::ForState &node) { walk(node.core); }
+
+    void References::visit(const __AST_NODE::WhileState &node) {
+        walk(node.condition);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::ElseState &node) {
+        walk(node.condition);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::IfState &node) {
+        walk(node.condition);
+        walk(node.body);
+        walk(node.else_body);
+    }
+
+    void References::visit(const __AST_NODE::SwitchCaseState &node) {
+        walk(node.condition);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::SwitchState &node) {
+        walk(node.condition);
+        walk(node.cases);
+    }
+
+    void References::visit(const __AST_NODE::YieldState &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::DeleteState &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::ImportState &) {}
+    void References::visit(const __AST_NODE::ImportItems &) {}
+    void References::visit(const __AST_NODE::SingleImport &) {}
+    void References::visit(const __AST_NODE::SpecImport &) {}
+    void References::visit(const __AST_NODE::MultiImportState &) {}
+    void References::visit(const __AST_NODE::ReturnState &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::BreakState &) {}
+    void References::visit(const __AST_NODE::BlockState &node) { walk(node.body); }
+    void References::visit(const __AST_NODE::SuiteState &node) { walk(node.body); }
+    void References::visit(const __AST_NODE::ContinueState &) {}
+
+    void References::visit(const __AST_NODE::CatchState &node) {
+        walk(node.catch_state);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::FinallyState &node) { walk(node.body); }
+
+    void References::visit(const __AST_NODE::TryState &node) {
+        walk(node.body);
+        walk(node.catch_states);
+        walk(node.finally_state);
+    }
+
+    void References::visit(const __AST_NODE::PanicState &node) { walk(node.expr); }
+    void References::visit(const __AST_NODE::ExprState &node) { walk(node.value); }
+
+    // ------------------------------------------------------------------------------------------ //
+
+    void References::visit(const __AST_NODE::RequiresParamDecl &node) {
+        walk(node.var);
+        walk(node.value);
+    }
+
+    void References::visit(const __AST_NODE::RequiresParamList &node) { walk(node.params); }
+    void References::visit(const __AST_NODE::EnumMemberDecl &node) { walk(node.value); }
+
+    void References::visit(const __AST_NODE::UDTDeriveDecl &node) {
+        for (const auto &derive : node.derives) {
+            walk(derive.first);
+        }
+    }
+
+    void References::visit(const __AST_NODE::TypeBoundList &node) { walk(node.bounds); }
+    void References::visit(const __AST_NODE::TypeBoundDecl &node) { walk(node.bound); }
+
+    void References::visit(const __AST_NODE::RequiresDecl &node) {
+        walk(node.params);
+        walk(node.bounds);
+    }
+
+    void References::visit(const __AST_NODE::ModuleDecl &node) { walk(node.body); }
+
+    void References::visit(const __AST_NODE::StructDecl &node) {
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::ExtendDecl &node) {
+        for (const auto &base : node.extends) {
+            walk(base.first);
+        }
+
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::ConstDecl &node) { walk(node.vars); }
+
+    void References::visit(const __AST_NODE::ClassDecl &node) {
+        for (const auto &base : node.extends) {
+            walk(base.first);
+        }
+
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::InterDecl &node) {
+        walk(node.derives);
+        walk(node.generics);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::EnumDecl &node) {
+        walk(node.derives);
+        walk(node.members);
+    }
+
+    void References::visit(const __AST_NODE::TypeDecl &node) {
+        walk(node.generics);
+        walk(node.type);
+    }
+
+    void References::visit(const __AST_NODE::FuncDecl &node) {
+        // the qualifier of an out of line definition (`Foo` in `fn Foo::bar()`) is a use
+        if (node.name != nullptr && node.name->type != __AST_NODE::PathExpr::PathType::Identifier) {
+            walk(node.name);
+        }
+
+        walk(node.generics);
+        walk(node.params);
+        walk(node.returns);
+        walk(node.body);
+    }
+
+    void References::visit(const __AST_NODE::VarDecl &node) {
+        walk(node.var);
+        walk(node.value);
+    }
+
+    void References::visit(const __AST_NODE::FFIDecl &node) { walk(node.value); }
+    void References::visit(const __AST_NODE::LetDecl &node) { walk(node.vars); }
+    void References::visit(const __AST_NODE::OpDecl &node) { walk(node.func); }
+
+    void References::visit(const __AST_NODE::Program &node) {
+        walk(node.children);
+        walk(node.annotations);
+    }
+}  // namespace __AST_VISITOR_BEGIN
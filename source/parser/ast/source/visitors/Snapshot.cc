@@ -0,0 +1,913 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------------- C++ ---///
+
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__) || defined(__linux__) || defined(__FreeBSD__) ||      \
+    defined(__NetBSD__) || defined(__OpenBSD__) || defined(__bsdi__) || defined(__DragonFly__) || \
+    defined(__MACH__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_HAS_MMAP
+#endif
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/private/base/AST_base.hh"
+#include "parser/ast/include/types/AST_snapshot.hh"
+#include "parser/ast/include/types/AST_visitor.hh"
+#include "token/include/private/Token_base.hh"
+
+namespace {
+using __AST_N::NodeT;
+using __AST_N::NodeV;
+using __TOKEN_N::Token;
+
+constexpr char MAGIC[4]     = {'H', 'X', 'A', 'S'};
+constexpr u32  NODE_WIDTH   = 3;  // u32s per entry of each table
+constexpr u32  TOKEN_WIDTH  = 7;
+constexpr u32  DEP_WIDTH    = 3;
+constexpr u32  IMPORT_WIDTH = 2;
+
+/// the fields of every node in declaration order, shared by the writer and the reader so the two
+/// can not drift apart. `io` is called with the fields, const when writing
+#define FIELDS(name)                                                    \
+    template <typename IO, typename N>                                  \
+        requires std::same_as<std::remove_const_t<N>, __AST_NODE::name> \
+    void fields(IO &io, [[maybe_unused]] N &n)
+
+// -- expressions -- //
+FIELDS(LiteralExpr) { io(n.value, n.type, n.contains_format_args, n.format_args); }
+FIELDS(BinaryExpr) { io(n.lhs, n.op, n.rhs); }
+FIELDS(UnaryExpr) { io(n.opd, n.op, n.type, n.in_type); }
+FIELDS(IdentExpr) { io(n.name, n.is_reserved_primitive); }
+FIELDS(NamedArgumentExpr) { io(n.name, n.value); }
+FIELDS(ArgumentExpr) { io(n.value, n.type); }
+FIELDS(ArgumentListExpr) { io(n.args); }
+FIELDS(GenericInvokeExpr) { io(n.args); }
+FIELDS(ScopePathExpr) { io(n.path, n.access, n.global_scope); }
+FIELDS(DotPathExpr) { io(n.lhs, n.rhs); }
+FIELDS(ArrayAccessExpr) { io(n.lhs, n.rhs); }
+FIELDS(PathExpr) { io(n.path, n.type); }
+FIELDS(FunctionCallExpr) { io(n.path, n.args, n.generic); }
+FIELDS(ArrayLiteralExpr) { io(n.values); }
+FIELDS(TupleLiteralExpr) { io(n.values, n.in_type); }
+FIELDS(SetLiteralExpr) { io(n.values); }
+FIELDS(MapPairExpr) { io(n.key, n.value); }
+FIELDS(MapLiteralExpr) { io(n.values); }
+FIELDS(ObjInitExpr) { io(n.kwargs, n.path); }
+FIELDS(LambdaExpr) { io(n.marker, n.params, n.generics, n.returns, n.body); }
+FIELDS(TernaryExpr) { io(n.condition, n.if_true, n.if_false); }
+FIELDS(ParenthesizedExpr) { io(n.value); }
+FIELDS(CastExpr) { io(n.value, n.type); }
+FIELDS(InstOfExpr) { io(n.value, n.type, n.marker, n.in_requires, n.op); }
+FIELDS(AsyncThreading) { io(n.value, n.type); }
+FIELDS(Type) {
+    io(n.marker,
+       n.value,
+       n.generics,
+       n.nullable,
+       n.nullable_marker,
+       n.is_fn_ptr,
+       n.fn_ptr,
+       n.specifiers);
+}
+
+// -- statements -- //
+FIELDS(NamedVarSpecifier) { io(n.path, n.type, n.is_const); }
+FIELDS(NamedVarSpecifierList) { io(n.vars); }
+FIELDS(ForPyStatementCore) { io(n.in_marker, n.vars, n.range, n.body); }
+FIELDS(ForCStatementCore) { io(n.init, n.condition, n.update, n.body); }
+FIELDS(ForState) { io(n.core, n.type); }
+FIELDS(WhileState) { io(n.condition, n.body); }
+FIELDS(ElseState) { io(n.condition, n.body, n.type); }
+FIELDS(IfState) { io(n.condition, n.body, n.else_body, n.type, n.has_const, n.has_eval); }
+FIELDS(SwitchCaseState) { io(n.condition, n.body, n.type, n.marker); }
+FIELDS(SwitchState) { io(n.condition, n.cases); }
+FIELDS(YieldState) { io(n.value, n.marker); }
+FIELDS(DeleteState) { io(n.value); }
+FIELDS(ImportState) { io(n.import, n.type, n.explicit_module); }
+FIELDS(ImportItems) { io(n.imports); }
+FIELDS(SingleImport) { io(n.alias, n.path, n.type, n.is_wildcard); }
+FIELDS(SpecImport) { io(n.path, n.imports, n.type); }
+FIELDS(MultiImportState) { io(); }
+FIELDS(ReturnState) { io(n.value); }
+FIELDS(BreakState) { io(n.marker); }
+FIELDS(BlockState) { io(n.body); }
+FIELDS(SuiteState) { io(n.body); }
+FIELDS(ContinueState) { io(n.marker); }
+FIELDS(CatchState) { io(n.catch_state, n.body); }
+FIELDS(FinallyState) { io(n.body); }
+FIELDS(TryState) { io(n.body, n.catch_states, n.finally_state, n.no_catch); }
+FIELDS(PanicState) { io(n.expr, n.marker); }
+FIELDS(ExprState) { io(n.value); }
+
+// -- declarations -- //
+FIELDS(RequiresParamDecl) { io(n.var, n.value, n.is_const); }
+FIELDS(RequiresParamList) { io(n.params); }
+FIELDS(EnumMemberDecl) { io(n.name, n.value); }
+FIELDS(UDTDeriveDecl) { io(n.derives); }
+FIELDS(TypeBoundList) { io(n.bounds); }
+FIELDS(TypeBoundDecl) { io(n.bound); }
+FIELDS(RequiresDecl) { io(n.params, n.bounds); }
+FIELDS(ModuleDecl) { io(n.body, n.name, n.inline_module); }
+FIELDS(StructDecl) { io(n.name, n.derives, n.generics, n.body, n.modifiers); }
+FIELDS(ExtendDecl) { io(n.extends, n.name, n.derives, n.generics, n.body, n.modifiers); }
+FIELDS(ConstDecl) { io(n.modifiers, n.vis, n.vars); }
+FIELDS(ClassDecl) { io(n.extends, n.modifiers, n.name, n.derives, n.generics, n.body); }
+FIELDS(InterDecl) { io(n.modifiers, n.name, n.derives, n.generics, n.body); }
+FIELDS(EnumDecl) { io(n.vis, n.name, n.derives, n.members); }
+FIELDS(TypeDecl) { io(n.vis, n.name, n.generics, n.type); }
+FIELDS(FuncDecl) {
+    io(n.modifiers, n.qualifiers, n.marker, n.name, n.params, n.generics, n.returns, n.body);
+}
+FIELDS(VarDecl) { io(n.var, n.value); }
+FIELDS(FFIDecl) { io(n.vis, n.name, n.value); }
+FIELDS(LetDecl) { io(n.modifiers, n.vis, n.vars); }
+FIELDS(OpDecl) { io(n.modifiers, n.op, n.func); }
+
+FIELDS(Program) { io(n.children, n.annotations, n.directives, n.filename, n.entry); }
+
+#undef FIELDS
+
+/// a node with placeholder fields for the reader to fill in, nullptr for the nodes the parser
+/// never builds (they have no constructor)
+template <typename T>
+NodeT<T> blank();
+
+#define BLANK(name, ...)                                          \
+    template <>                                                   \
+    NodeT<__AST_NODE::name> blank<__AST_NODE::name>() {           \
+        return __AST_N::make_node<__AST_NODE::name>(__VA_ARGS__); \
+    }
+
+BLANK(LiteralExpr, Token(), __AST_NODE::LiteralExpr::LiteralType::Integer)
+BLANK(BinaryExpr, nullptr, nullptr, Token())
+BLANK(UnaryExpr, nullptr, Token(), __AST_NODE::UnaryExpr::PosType::PreFix)
+BLANK(IdentExpr, Token())
+BLANK(NamedArgumentExpr, nullptr, nullptr)
+BLANK(ArgumentExpr, nullptr)
+BLANK(ArgumentListExpr, false)
+BLANK(GenericInvokeExpr, NodeV<>())
+BLANK(ScopePathExpr, false)
+BLANK(DotPathExpr, nullptr, nullptr)
+BLANK(ArrayAccessExpr, nullptr, nullptr)
+BLANK(PathExpr, nullptr)
+BLANK(FunctionCallExpr, nullptr, nullptr)
+BLANK(ArrayLiteralExpr, nullptr)
+BLANK(TupleLiteralExpr, nullptr)
+BLANK(SetLiteralExpr, nullptr)
+BLANK(MapPairExpr, nullptr, nullptr)
+BLANK(MapLiteralExpr, nullptr)
+BLANK(ObjInitExpr, false)
+BLANK(LambdaExpr, Token())
+BLANK(TernaryExpr, nullptr, nullptr, nullptr)
+BLANK(ParenthesizedExpr, nullptr)
+BLANK(CastExpr, nullptr, nullptr)
+BLANK(InstOfExpr, nullptr, nullptr, __AST_NODE::InstOfExpr::InstanceType::Has, Token())
+BLANK(AsyncThreading, nullptr, Token())
+BLANK(Type, false)
+
+BLANK(NamedVarSpecifier, false)
+BLANK(NamedVarSpecifierList, false)
+BLANK(ForPyStatementCore, false)
+BLANK(ForCStatementCore, false)
+BLANK(ForState, nullptr, __AST_NODE::ForState::ForType::Python)
+BLANK(WhileState, nullptr, nullptr)
+BLANK(ElseState, false)
+BLANK(IfState, nullptr)
+BLANK(SwitchCaseState, nullptr, nullptr, __AST_NODE::SwitchCaseState::CaseType::Case, Token())
+BLANK(SwitchState, nullptr)
+BLANK(YieldState, nullptr, Token())
+BLANK(DeleteState, nullptr)
+BLANK(ImportState, NodeT<__AST_NODE::SingleImport>(), false)
+BLANK(ImportItems, NodeT<__AST_NODE::SingleImport>())
+BLANK(SingleImport, __AST_NODE::SingleImport::Type::Module)
+BLANK(SpecImport, NodeT<__AST_NODE::ScopePathExpr>())
+BLANK(ReturnState, nullptr)
+BLANK(BreakState, Token())
+BLANK(BlockState, NodeV<>())
+BLANK(SuiteState, nullptr)
+BLANK(ContinueState, Token())
+BLANK(CatchState, nullptr, nullptr)
+BLANK(FinallyState, nullptr)
+BLANK(TryState, NodeT<__AST_NODE::SuiteState>())
+BLANK(PanicState, nullptr, Token())
+BLANK(ExprState, nullptr)
+
+BLANK(RequiresParamDecl, false)
+BLANK(RequiresParamList, NodeT<__AST_NODE::RequiresParamDecl>())
+BLANK(EnumMemberDecl, nullptr)
+BLANK(UDTDeriveDecl,
+      std::make_pair(NodeT<__AST_NODE::Type>(),
+                     __AST_N::AccessSpecifier(Token(__TOKEN_N::KEYWORD_PUBLIC, std::string()))))
+BLANK(TypeBoundList, nullptr)
+BLANK(RequiresDecl, nullptr)
+BLANK(ModuleDecl, nullptr, nullptr)
+BLANK(StructDecl, false)
+BLANK(ExtendDecl, false)
+BLANK(ConstDecl, false)
+BLANK(ClassDecl, false)
+BLANK(InterDecl, false)
+BLANK(EnumDecl, false)
+BLANK(TypeDecl, false)
+BLANK(FuncDecl, false)
+BLANK(VarDecl, nullptr)
+BLANK(FFIDecl, false)
+BLANK(LetDecl, false)
+BLANK(OpDecl, false)
+
+#undef BLANK
+
+template <>
+NodeT<__AST_NODE::TypeBoundDecl> blank<__AST_NODE::TypeBoundDecl>() {
+    return nullptr;
+}
+
+template <>
+NodeT<__AST_NODE::MultiImportState> blank<__AST_NODE::MultiImportState>() {
+    return nullptr;
+}
+
+using Modifier = decltype(__AST_N::Modifiers::modifiers)::value_type;
+using Derives  = std::vector<std::pair<NodeT<__AST_NODE::Type>, __AST_N::AccessSpecifier>>;
+
+/// lays a Program out as snapshot tables, each node's slots are collected while its children are
+/// written and appended once it is done so they stay contiguous
+class Writer : public __AST_VISITOR::Visitor {
+  public:
+    bool             ok = true;
+    std::vector<u32> nodes;
+    std::vector<u32> slots;
+    std::vector<u32> tokens;
+    std::vector<u32> string_offsets{0};
+    std::string      strings;
+
+    void program(const __AST_NODE::Program &program) {
+        nodes.insert(nodes.end(), {static_cast<u32>(__AST_NODE::nodes::Program), 0, 0});
+        finish(0, [&] { fields(*this, program); });
+    }
+
+    u32 intern(std::string_view str) {
+        auto [found, inserted] =
+            string_ids.try_emplace(std::string(str), static_cast<u32>(string_offsets.size() - 1));
+
+        if (inserted) {
+            strings.append(str);
+            string_offsets.push_back(static_cast<u32>(strings.size()));
+        }
+
+        return found->second;
+    }
+
+    template <typename... Fields>
+    void operator()(const Fields &...values) {
+        (put(values), ...);
+    }
+
+#define SNAPSHOT_VISIT(name) \
+    void visit(const __AST_NODE::name &node) override { fields(*this, node); }
+    GENERATE_MACRO_HELPER(SNAPSHOT_VISIT)
+#undef SNAPSHOT_VISIT
+
+    void visit(const __AST_NODE::Program &node) override { fields(*this, node); }
+
+  private:
+    std::unordered_map<std::string, u32>         string_ids;
+    std::unordered_map<const __AST_NODE::Node *, u32> written;
+    std::vector<u32>                            *current = nullptr;
+
+    template <typename Body>
+    void finish(u32 index, Body &&body) {
+        std::vector<u32>  own;
+        std::vector<u32> *parent = std::exchange(current, &own);
+
+        body();
+
+        current                               = parent;
+        nodes[(index * NODE_WIDTH) + 1]       = static_cast<u32>(slots.size());
+        nodes[(index * NODE_WIDTH) + 2]       = static_cast<u32>(own.size());
+        slots.insert(slots.end(), own.begin(), own.end());
+    }
+
+    template <typename T>
+    void put(const NodeT<T> &node) {
+        if (node == nullptr) {
+            current->push_back(__AST_N::Snapshot::NONE);
+            return;
+        }
+
+        // a node shared by several parents is written once and shared again when it is read
+        if (auto found = written.find(node.get()); found != written.end()) {
+            current->push_back(found->second);
+            return;
+        }
+
+        const auto index = static_cast<u32>(nodes.size() / NODE_WIDTH);
+        written.emplace(node.get(), index);
+        nodes.insert(nodes.end(), {static_cast<u32>(node->getNodeType()), 0, 0});
+
+        finish(index, [&] { node->accept(*this); });
+        current->push_back(index);
+    }
+
+    template <typename T>
+    void put(const NodeV<T> &list) {
+        current->push_back(static_cast<u32>(list.size()));
+
+        for (const auto &node : list) {
+            put(node);
+        }
+    }
+
+    void put(const Token &tok) {
+        current->push_back(static_cast<u32>(tokens.size() / TOKEN_WIDTH));
+        tokens.insert(tokens.end(),
+                      {static_cast<u32>(tok.token_kind()),
+                       tok.line_number(),
+                       tok.column_number(),
+                       tok.length(),
+                       tok.offset(),
+                       intern(tok.get_value()),
+                       intern(tok.get_file_name())});
+    }
+
+    void put(const std::vector<Token> &list) {
+        current->push_back(static_cast<u32>(list.size()));
+
+        for (const auto &tok : list) {
+            put(tok);
+        }
+    }
+
+    void put(const std::string &str) { current->push_back(intern(str)); }
+    void put(bool flag) { current->push_back(flag ? 1 : 0); }
+
+    template <typename E>
+        requires std::is_enum_v<E>
+    void put(E value) {
+        current->push_back(static_cast<u32>(value));
+    }
+
+    void put(const __AST_N::Modifiers &mods) {
+        current->push_back(static_cast<u32>(mods.modifiers.size()));
+
+        for (const Modifier &mod : mods.modifiers) {
+            current->push_back(static_cast<u32>(mod.index()));
+            std::visit([&](const auto &spec) { put(spec.marker); }, mod);
+        }
+    }
+
+    void put(const Derives &derives) {
+        current->push_back(static_cast<u32>(derives.size()));
+
+        for (const auto &[type, access] : derives) {
+            put(type);
+            put(access.marker);
+        }
+    }
+
+    void put(const __AST_NODE::Type::FnPtr &fn_ptr) {
+        put(fn_ptr.marker);
+        put(fn_ptr.params);
+        put(fn_ptr.returns);
+    }
+};
+
+/// rebuilds heap nodes from a view, any slot that does not fit what the node kind expects fails
+/// the whole load
+class Reader {
+  public:
+    bool ok = true;
+
+    explicit Reader(const __AST_N::SnapshotView &view)
+        : view(view)
+        , done(view.node_count())
+        , busy(view.node_count(), false) {}
+
+    NodeT<__AST_NODE::Program> program(__TOKEN_N::TokenList &source) {
+        auto program = __AST_N::make_node<__AST_NODE::Program>(source, std::string());
+
+        enter(0, [&] { fields(*this, *program); });
+        return ok ? program : nullptr;
+    }
+
+    template <typename... Fields>
+    void operator()(Fields &...values) {
+        (get(values), ...);
+    }
+
+  private:
+    const __AST_N::SnapshotView &view;
+    std::vector<NodeT<>>         done;
+    std::vector<bool>            busy;
+    const u32                   *pos = nullptr;
+    const u32                   *end = nullptr;
+
+    u32 next() {
+        if (pos == end) {
+            ok = false;
+            return __AST_N::Snapshot::NONE;
+        }
+
+        return *pos++;
+    }
+
+    /// \returns a count read from the slots, 0 if it is more than the slots left could hold
+    u32 count() {
+        const u32 size = next();
+
+        if (size > static_cast<u32>(end - pos)) {
+            ok = false;
+            return 0;
+        }
+
+        return size;
+    }
+
+    template <typename Body>
+    void enter(u32 index, Body &&body) {
+        const std::span<const u32> own    = view.slots(index);
+        const u32                 *outer  = std::exchange(pos, own.data());
+        const u32                 *outer_end = std::exchange(end, own.data() + own.size());
+
+        body();
+
+        if (pos != end) {  // every slot is a field, none may be left over
+            ok = false;
+        }
+
+        pos = outer;
+        end = outer_end;
+    }
+
+    template <typename T>
+    NodeT<> read(u32 index) {
+        NodeT<T> node = blank<T>();
+
+        if (node == nullptr) {
+            ok = false;
+            return nullptr;
+        }
+
+        done[index] = node;
+        busy[index] = true;
+        enter(index, [&] { fields(*this, *node); });
+        busy[index] = false;
+
+        return node;
+    }
+
+    NodeT<> node(u32 index) {
+        if (index == 0 || index >= view.node_count() || busy[index]) {  // 0 is the Program
+            ok = false;
+            return nullptr;
+        }
+
+        if (done[index] != nullptr) {
+            return done[index];
+        }
+
+        switch (view.kind(index)) {
+#define SNAPSHOT_READ(name)         \
+    case __AST_NODE::nodes::name: \
+        return read<__AST_NODE::name>(index);
+            GENERATE_MACRO_HELPER(SNAPSHOT_READ)
+#undef SNAPSHOT_READ
+            case __AST_NODE::nodes::Program:
+                break;
+        }
+
+        ok = false;
+        return nullptr;
+    }
+
+    template <typename T>
+    void get(NodeT<T> &out) {
+        const u32 index = next();
+
+        if (!ok || index == __AST_N::Snapshot::NONE) {
+            out = nullptr;
+            return;
+        }
+
+        NodeT<> child = node(index);
+
+        if constexpr (std::same_as<T, __AST_NODE::Node>) {
+            out = std::move(child);
+        } else {
+            out = std::dynamic_pointer_cast<T>(child);
+
+            if (out == nullptr) {
+                ok = false;
+            }
+        }
+    }
+
+    template <typename T>
+    void get(NodeV<T> &out) {
+        out.clear();
+        out.resize(count());
+
+        for (auto &node : out) {
+            get(node);
+        }
+    }
+
+    void get(Token &out) {
+        const u32 index = next();
+
+        if (!ok || index >= view.token_count()) {
+            ok = false;
+            return;
+        }
+
+        const __AST_N::SnapshotView::TokenRef tok = view.token(index);
+        out = Token(tok.kind,
+                    tok.line,
+                    tok.column,
+                    tok.length,
+                    tok.offset,
+                    std::string(tok.value),
+                    std::string(tok.file));
+    }
+
+    void get(std::vector<Token> &out) {
+        out.clear();
+        out.resize(count());
+
+        for (auto &tok : out) {
+            get(tok);
+        }
+    }
+
+    void get(std::string &out) {
+        const u32 index = next();
+
+        if (!ok || index >= view.string_count()) {
+            ok = false;
+            return;
+        }
+
+        out = view.string(index);
+    }
+
+    void get(bool &out) {
+        const u32 value = next();
+
+        ok  = ok && value <= 1;
+        out = value == 1;
+    }
+
+    template <typename E>
+        requires std::is_enum_v<E>
+    void get(E &out) {
+        const u32 value = next();
+        const auto raw  = static_cast<std::underlying_type_t<E>>(value);
+
+        if (static_cast<u32>(raw) != value) {
+            ok = false;
+            return;
+        }
+
+        out = static_cast<E>(raw);
+    }
+
+    /// the specifiers rebuild their kind from their marker the way the parser makes them
+    template <size_t I = 0>
+    void add_modifier(__AST_N::Modifiers &mods, u32 alternative, Token &&marker) {
+        if constexpr (I < std::variant_size_v<Modifier>) {
+            if (alternative == I) {
+                mods.modifiers.emplace_back(
+                    std::variant_alternative_t<I, Modifier>(std::move(marker)));
+                return;
+            }
+
+            add_modifier<I + 1>(mods, alternative, std::move(marker));
+        } else {
+            ok = false;
+        }
+    }
+
+    void get(__AST_N::Modifiers &mods) {
+        const u32 size = count();
+        mods.modifiers.clear();
+
+        for (u32 i = 0; i < size && ok; ++i) {
+            const u32 alternative = next();
+            Token     marker;
+
+            get(marker);
+
+            if (ok) {
+                add_modifier(mods, alternative, std::move(marker));
+            }
+        }
+    }
+
+    void get(Derives &derives) {
+        const u32 size = count();
+        derives.clear();
+
+        for (u32 i = 0; i < size && ok; ++i) {
+            NodeT<__AST_NODE::Type> type;
+            Token                   marker;
+
+            get(type);
+            get(marker);
+
+            if (ok) {
+                derives.emplace_back(std::move(type), __AST_N::AccessSpecifier(std::move(marker)));
+            }
+        }
+    }
+
+    void get(__AST_NODE::Type::FnPtr &fn_ptr) {
+        get(fn_ptr.marker);
+        get(fn_ptr.params);
+        get(fn_ptr.returns);
+    }
+};
+
+void append(std::string &out, const void *data, size_t size) {
+    out.append(static_cast<const char *>(data), size);
+}
+
+void append(std::string &out, const std::vector<u32> &table) {
+    append(out, table.data(), table.size() * sizeof(u32));
+}
+}  // namespace
+
+__AST_BEGIN {
+    std::string Snapshot::write(const __AST_NODE::Program     &program,
+                                u64                            stamp,
+                                const std::vector<Dependency> &dependencies,
+                                const std::vector<Import>     &imports) {
+        Writer writer;
+        writer.program(program);
+
+        if (!writer.ok) {
+            return {};
+        }
+
+        std::vector<u32> dependency_table;
+        std::vector<u32> import_table;
+
+        for (const auto &[path, hash] : dependencies) {
+            dependency_table.insert(
+                dependency_table.end(),
+                {writer.intern(path), static_cast<u32>(hash), static_cast<u32>(hash >> 32)});
+        }
+
+        for (const auto &[path, prune] : imports) {
+            import_table.insert(import_table.end(), {writer.intern(path), prune ? 1U : 0U});
+        }
+
+        SnapshotView::Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version          = VERSION;
+        header.stamp            = stamp;
+        header.node_count       = static_cast<u32>(writer.nodes.size() / NODE_WIDTH);
+        header.slot_count       = static_cast<u32>(writer.slots.size());
+        header.token_count      = static_cast<u32>(writer.tokens.size() / TOKEN_WIDTH);
+        header.string_count     = static_cast<u32>(writer.string_offsets.size() - 1);
+        header.string_bytes     = static_cast<u32>(writer.strings.size());
+        header.dependency_count = static_cast<u32>(dependencies.size());
+        header.import_count     = static_cast<u32>(imports.size());
+
+        std::string out;
+        out.reserve(sizeof(header) + writer.strings.size() + sizeof(u32) * 4 +
+                    ((writer.nodes.size() + writer.slots.size() + writer.tokens.size() +
+                      writer.string_offsets.size() + dependency_table.size() +
+                      import_table.size()) *
+                     sizeof(u32)));
+
+        append(out, &header, sizeof(header));
+        append(out, writer.nodes);
+        append(out, writer.slots);
+        append(out, writer.tokens);
+        append(out, writer.string_offsets);
+        out += writer.strings;
+        out.append((sizeof(u32) - (out.size() % sizeof(u32))) % sizeof(u32), '\0');
+        append(out, dependency_table);
+        append(out, import_table);
+
+        return out;
+    }
+
+    std::optional<SnapshotView> SnapshotView::open(std::span<const std::byte> bytes) {
+        SnapshotView view;
+
+        if (bytes.size() < sizeof(Header) ||
+            reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(u32) != 0) {
+            return std::nullopt;
+        }
+
+        std::memcpy(&view.header, bytes.data(), sizeof(Header));
+        const Header &header = view.header;
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != Snapshot::VERSION ||
+            header.node_count == 0) {
+            return std::nullopt;
+        }
+
+        const size_t string_space = (size_t(header.string_bytes) + sizeof(u32) - 1) / sizeof(u32);
+        const size_t words = (size_t(header.node_count) * NODE_WIDTH) + header.slot_count +
+                             (size_t(header.token_count) * TOKEN_WIDTH) + header.string_count + 1 +
+                             string_space + (size_t(header.dependency_count) * DEP_WIDTH) +
+                             (size_t(header.import_count) * IMPORT_WIDTH);
+
+        if (bytes.size() != sizeof(Header) + (words * sizeof(u32))) {
+            return std::nullopt;
+        }
+
+        const auto *cursor = reinterpret_cast<const u32 *>(bytes.data() + sizeof(Header));
+
+        view.nodes_table = cursor;
+        cursor += size_t(header.node_count) * NODE_WIDTH;
+        view.slot_table = cursor;
+        cursor += header.slot_count;
+        view.token_table = cursor;
+        cursor += size_t(header.token_count) * TOKEN_WIDTH;
+        view.string_table = cursor;
+        cursor += size_t(header.string_count) + 1;
+        view.strings = reinterpret_cast<const char *>(cursor);
+        cursor += string_space;
+        view.dependency_table = cursor;
+        cursor += size_t(header.dependency_count) * DEP_WIDTH;
+        view.import_table = cursor;
+
+        // one pass over the tables so the accessors never read out of range, the slots are only
+        // checked by `load` since what they hold depends on the node kind
+        if (view.string_table[0] != 0) {
+            return std::nullopt;
+        }
+
+        for (u32 i = 0; i < header.string_count; ++i) {
+            if (view.string_table[i] > view.string_table[i + 1] ||
+                view.string_table[i + 1] > header.string_bytes) {
+                return std::nullopt;
+            }
+        }
+
+        for (u32 i = 0; i < header.node_count; ++i) {
+            const u32 *entry = view.nodes_table + (size_t(i) * NODE_WIDTH);
+
+            if (entry[0] > static_cast<u32>(__AST_NODE::nodes::Program) ||
+                (entry[0] == static_cast<u32>(__AST_NODE::nodes::Program)) != (i == 0) ||
+                size_t(entry[1]) + entry[2] > header.slot_count) {
+                return std::nullopt;
+            }
+        }
+
+        for (u32 i = 0; i < header.token_count; ++i) {
+            const u32 *entry = view.token_table + (size_t(i) * TOKEN_WIDTH);
+
+            if (entry[0] >= __TOKEN_N::tokens_map.size() || entry[5] >= header.string_count ||
+                entry[6] >= header.string_count) {
+                return std::nullopt;
+            }
+        }
+
+        for (u32 i = 0; i < header.dependency_count; ++i) {
+            if (view.dependency_table[size_t(i) * DEP_WIDTH] >= header.string_count) {
+                return std::nullopt;
+            }
+        }
+
+        for (u32 i = 0; i < header.import_count; ++i) {
+            const u32 *entry = view.import_table + (size_t(i) * IMPORT_WIDTH);
+
+            if (entry[0] >= header.string_count || entry[1] > 1) {
+                return std::nullopt;
+            }
+        }
+
+        return view;
+    }
+
+    __AST_NODE::nodes SnapshotView::kind(u32 node) const {
+        return static_cast<__AST_NODE::nodes>(nodes_table[size_t(node) * NODE_WIDTH]);
+    }
+
+    std::span<const u32> SnapshotView::slots(u32 node) const {
+        const u32 *entry = nodes_table + (size_t(node) * NODE_WIDTH);
+        return {slot_table + entry[1], entry[2]};
+    }
+
+    SnapshotView::TokenRef SnapshotView::token(u32 index) const {
+        const u32 *entry = token_table + (size_t(index) * TOKEN_WIDTH);
+
+        return {static_cast<__TOKEN_N::tokens>(entry[0]),
+                entry[1],
+                entry[2],
+                entry[3],
+                entry[4],
+                string(entry[5]),
+                string(entry[6])};
+    }
+
+    std::string_view SnapshotView::string(u32 index) const {
+        return {strings + string_table[index], string_table[index + 1] - string_table[index]};
+    }
+
+    SnapshotView::DependencyRef SnapshotView::dependency(u32 index) const {
+        const u32 *entry = dependency_table + (size_t(index) * DEP_WIDTH);
+        return {string(entry[0]), (static_cast<u64>(entry[2]) << 32) | entry[1]};
+    }
+
+    SnapshotView::ImportRef SnapshotView::import(u32 index) const {
+        const u32 *entry = import_table + (size_t(index) * IMPORT_WIDTH);
+        return {string(entry[0]), entry[1] == 1};
+    }
+
+    NodeT<__AST_NODE::Program> SnapshotView::load(__TOKEN_N::TokenList &tokens) const {
+        try {  // a specifier whose marker is not one throws, like it does in the parser
+            Reader reader(*this);
+            return reader.program(tokens);
+        } catch (const std::exception &) {
+            return nullptr;
+        }
+    }
+
+    SnapshotFile::SnapshotFile(const std::filesystem::path &path) {
+#ifdef SNAPSHOT_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info {};
+
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *bytes =
+                ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (bytes != MAP_FAILED) {
+                data   = static_cast<const std::byte *>(bytes);
+                size   = static_cast<size_t>(info.st_size);
+                mapped = true;
+            }
+        }
+
+        ::close(fd);
+
+        if (mapped) {
+            return;
+        }
+#endif
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file) {
+            return;
+        }
+
+        std::string bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        fallback.resize(bytes.size());
+        std::memcpy(fallback.data(), bytes.data(), bytes.size());
+
+        data = fallback.data();
+        size = fallback.size();
+    }
+
+    SnapshotFile::~SnapshotFile() {
+#ifdef SNAPSHOT_HAS_MMAP
+        if (mapped) {
+            ::munmap(const_cast<std::byte *>(data), size);
+        }
+#endif
+    }
+
+    std::optional<SnapshotView> SnapshotFile::view() const {
+        if (data == nullptr) {
+            return std::nullopt;
+        }
+
+        return SnapshotView::open({data, size});
+    }
+}  // namespace __AST_BEGIN
@@ -39,8 +39,10 @@
 ///-------------------------------------------------------------------------------------- C++ ---///
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -83,6 +85,10 @@
 #endif
 
 inline std::vector<CXXCompileAction> COMPILE_ACTIONS;
+
+/// every module of the build by resolved path, a module imported along several paths is built
+/// once and shared by all of them. nullptr for a module that failed to build
+inline std::unordered_map<std::string, std::shared_ptr<CompilationUnit>> IMPORTED_MODULES;
 __PREPROCESSOR_BEGIN {
     class ImportProcessor {
       private:
@@ -112,7 +118,15 @@ __PREPROCESSOR_BEGIN {
         using InstCXX      = std::variant<std::pair<std::string, std::string>, std::string>;
         using ResolvedPath = std::tuple<std::filesystem::path, size_t, Type>;
 
-        std::vector<generator::CXIR::CXIR> imports;
+        /// an imported module, its cx-ir is only generated once the importing unit has been parsed
+        /// so that only the declarations the importer reaches are emitted
+        struct Import {
+            std::shared_ptr<CompilationUnit> unit;
+            std::string file;  ///< the path it was built from, see `reimport`
+            bool prune = true;  ///< false for the core, codegen refers to it without naming it
+        };
+
+        std::vector<Import> imports;
 
         ImportProcessor(__TOKEN_N::TokenList               &tokens,
                         std::vector<std::filesystem::path> &import_dirs,
@@ -146,6 +160,10 @@ __PREPROCESSOR_BEGIN {
         bool has_processable_import();
         void force_import(const std::filesystem::path &path, __CONTROLLER_CLI_N::CLIArgs args);
 
+        /// imports the module `file` again as a restored unit had imported it, without the import
+        /// statement that did so
+        void reimport(const std::string &file, bool prune);
+
         void append(const std::filesystem::path                        &path,
                     size_t                                    rel_to_index,
                     Type                                      type,
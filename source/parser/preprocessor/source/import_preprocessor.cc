@@ -58,6 +58,29 @@ __PREPROCESSOR_BEGIN {
         }
     };
 
+    /// \returns the unit of the module `parsed_args.file`, built the first time an import reaches
+    /// it. nullptr if it failed to build
+    std::shared_ptr<CompilationUnit> build_module(__CONTROLLER_CLI_N::CLIArgs &parsed_args) {
+        std::error_code   ec;
+        const std::string key =
+            std::filesystem::weakly_canonical(parsed_args.file, ec).generic_string();
+
+        if (auto found = IMPORTED_MODULES.find(key); found != IMPORTED_MODULES.end()) {
+            return found->second;
+        }
+
+        // registered before it is built, an import cycle back to it finds it instead of recursing
+        auto unit             = std::make_shared<CompilationUnit>();
+        IMPORTED_MODULES[key] = unit;
+
+        if (unit->build_unit(parsed_args, false, true).second == 1) {
+            IMPORTED_MODULES[key] = nullptr;
+            return nullptr;
+        }
+
+        return unit;
+    }
+
     __TOKEN_N::TokenList ImportProcessor::normalize_scope_path(const ASTScopePath &scope,
                                                                Token               start_tok) {
         __TOKEN_N::TokenList final_path;
@@ -778,7 +801,6 @@ __PREPROCESSOR_BEGIN {
     /// \param parsed_args the parsed cli args
     void ImportProcessor::force_import(const std::filesystem::path           &path,
                                        __CONTROLLER_CLI_N::CLIArgs /* copy */ parsed_args) {
-        CompilationUnit unit;  // create a new compile unit instance
         parsed_args.file = path.generic_string();
 
         // check if the file exists and is a regular file by this point this should always be
@@ -788,14 +810,26 @@ __PREPROCESSOR_BEGIN {
                 .err_code = 2.1001, .fix_fmt_args = {}, .err_fmt_args = {path.generic_string()}});
         }
 
-        auto [action, ec] = unit.build_unit(parsed_args, false, true);
+        auto unit = build_module(parsed_args);
+
+        if (unit == nullptr) {  /// if there was an error, skip this import
+            return;
+        }
+
+        this->imports.push_back({std::move(unit), parsed_args.file, false});
+    }
+
+    void ImportProcessor::reimport(const std::string &file, bool prune) {
+        __CONTROLLER_CLI_N::CLIArgs args = parsed_args;
+        args.file                        = file;
+
+        auto unit = build_module(args);
 
-        if (ec == 1) {  /// if there was an error, skip this import
+        if (unit == nullptr) {  /// if there was an error, skip this import
             return;
         }
 
-        generator::CXIR::CXIR forward_decls = unit.generate_cxir(false);
-        this->imports.push_back(std::move(forward_decls));
+        this->imports.push_back({std::move(unit), file, prune});
     }
 
     void ImportProcessor::append(const std::filesystem::path              &path,
@@ -805,7 +839,7 @@ __PREPROCESSOR_BEGIN {
                                  const std::vector<std::filesystem::path> &import_dirs,
                                  __CONTROLLER_CLI_N::CLIArgs              &parsed_args,
                                  __TOKEN_N::Token                         &start) {
-        CompilationUnit unit;  // create a new compile unit instance
+        auto unit = std::make_shared<CompilationUnit>();  // create a new compile unit instance
         parsed_args.file =
             (import_dirs[rel_to_index] / path).generic_string();  // set the file path
 
@@ -835,18 +869,17 @@ __PREPROCESSOR_BEGIN {
             // COMPILE_ACTIONS.emplace_back(std::move(action));  /// this needs to be included in
             /// the final compile action list
 
-            auto [action, ec] = unit.build_unit(parsed_args, false, true);
+            auto module = build_module(parsed_args);
 
-            if (ec == 1) {  /// if there was an error, skip this import
+            if (module == nullptr) {  /// if there was an error, skip this import
                 return;
             }
 
-            generator::CXIR::CXIR forward_decls = unit.generate_cxir(false);
-            this->imports.push_back(std::move(forward_decls));  /// this gets passed as an ptr
-                                                                /// during cxir generation
+            /// the cx-ir is generated by the root unit, after pruning to what its importers use
+            this->imports.push_back({std::move(module), parsed_args.file});
 
         } else if (type == Type::Header) {
-            __TOKEN_N::TokenList import_tokens = unit.pre_process(parsed_args, false);
+            __TOKEN_N::TokenList import_tokens = unit->pre_process(parsed_args, false);
 
             this->tokens.insert(
                 this->tokens.cbegin() +
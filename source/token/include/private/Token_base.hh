@@ -69,6 +69,22 @@ __TOKEN_BEGIN {
             , val(std::move(value))
             , filename(loc.filename) {}
 
+        /// restores a token exactly as it was stored, its kind is not looked up from its value
+        Token(tokens      token_type,
+              u64         line,
+              u64         column,
+              u64         length,
+              u64         offset,
+              std::string value,
+              std::string filename)
+            : line(line)
+            , column(column)
+            , len(length)
+            , _offset(offset)
+            , kind(token_type)
+            , val(std::move(value))
+            , filename(std::move(filename)) {}
+
         ~Token();
 
         /* ====-------------------------- getters ---------------------------==== */
@@ -82,6 +98,7 @@ __TOKEN_BEGIN {
         [[nodiscard]] std::string &get_value() const;
         std::string                token_kind_repr() const;
         std::string                file_name() const;
+        [[nodiscard]] const std::string &get_file_name() const;
         std::string                to_string() const;
 
         bool          operator==(const Token &rhs) const;
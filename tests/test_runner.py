@@ -7,6 +7,7 @@ import os
 import sys
 import subprocess
 import re
+import shlex
 import logging
 from tqdm import tqdm
 from concurrent.futures import ThreadPoolExecutor, as_completed
@@ -82,12 +83,19 @@ def parse_expected_output(file_path):
         logger.error(f"File '{file_path}' does not contain valid test markers.")
         return [], False
 
+def parse_compile_flags(file_path):
+    """Extract the extra compiler flags from a `// FLAGS: ...` line, if the file has one."""
+    with open(file_path, 'r') as file:
+        flags_match = re.search(r'^//\s*FLAGS:(.*)$', file.read(), re.MULTILINE)
+
+    return shlex.split(flags_match.group(1)) if flags_match else []
+
 def compile_and_execute(compiler_path, file_path, output_path):
     """Compile and execute the .hlx file."""
     logger.debug(f"Compiling file: {file_path}")
     try:
         # Compile the file
-        compile_cmd = [compiler_path, file_path, "--error", "-o", output_path]
+        compile_cmd = [compiler_path, file_path, "--error", *parse_compile_flags(file_path), "-o", output_path]
         logger.debug(f"Compile command: {' '.join(compile_cmd)}")
         compile_process = subprocess.run(compile_cmd, capture_output=True, text=True)
 